@@ -0,0 +1,293 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file AsyncDQNLearner.hpp
+ * \brief Contains declaration of the asynchronous Deep Q-learning learner (training the network in a separate thread).
+ * \author tkornut
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_ALGORITHMS_ASYNCDQNLEARNER_HPP_
+#define SRC_ALGORITHMS_ASYNCDQNLEARNER_HPP_
+
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <cmath>
+
+#include <logger/Log.hpp>
+
+#include <types/ObservationExperienceMemory.hpp>
+#include <algorithms/NetworkCloning.hpp>
+
+namespace mic {
+namespace algorithms {
+
+/*!
+ * \brief Learner of the actor/learner architecture: samples batches from the (shared) observation experience memory
+ * and trains the network in a separate thread, periodically publishing the copy of its weights to the actors.
+ * \author tkornuta
+ */
+class AsyncDQNLearner {
+public:
+	/*!
+	 * Constructor. Publishes the initial copy of the network.
+	 * @param neural_net_ Network to be trained - after start() it must not be accessed by other threads.
+	 * @param memory_ Memory the experiences are sampled from.
+	 * @param batch_size_ Size of the training batch.
+	 * @param learning_rate_ Learning rate.
+	 * @param target_update_interval_ Number of training steps between synchronizations of the target network (0: target network not used).
+	 * @param double_dqn_ Flag denoting whether the Double DQN targets should be used.
+	 * @param publish_interval_ Number of training steps between publications of the network.
+	 */
+	AsyncDQNLearner(mic::mlnn::BackpropagationNeuralNetwork<float> & neural_net_, mic::types::ObservationExperienceMemory & memory_,
+			size_t batch_size_, float learning_rate_, size_t target_update_interval_, bool double_dqn_, size_t publish_interval_) :
+		neural_net(neural_net_), memory(memory_), batch_size(batch_size_), learning_rate(learning_rate_),
+		target_update_interval(target_update_interval_), double_dqn(double_dqn_), publish_interval((publish_interval_ > 0) ? publish_interval_ : 1),
+		running(false), number_of_training_steps(0), published_version(0)
+	{
+		if (target_update_interval > 0)
+			target_net = cloneNetwork(neural_net);
+		publishNetwork();
+	}
+
+	/*!
+	 * Destructor - stops the learner thread.
+	 */
+	virtual ~AsyncDQNLearner() {
+		stop();
+	}
+
+	/*!
+	 * Starts the learner thread.
+	 */
+	void start() {
+		if (running)
+			return;
+		running = true;
+		learner_thread = std::thread(&AsyncDQNLearner::run, this);
+	}
+
+	/*!
+	 * Stops the learner thread (waits till the current training step is finished).
+	 */
+	void stop() {
+		running = false;
+		if (learner_thread.joinable())
+			learner_thread.join();
+	}
+
+	/*!
+	 * Returns the recently published network if its version differs from the one passed as argument.
+	 * The returned network is not used by the learner anymore, however it is shared by all the callers,
+	 * so actors running in separate threads should clone it.
+	 * @param version_ Version of the network owned by the caller - updated if a newer network was returned.
+	 * @return Newer network or empty pointer if there is no newer version.
+	 */
+	std::shared_ptr<mic::mlnn::BackpropagationNeuralNetwork<float> > getPublishedNetwork(size_t & version_) {
+		std::lock_guard<std::mutex> lock(publish_mutex);
+		if (version_ == published_version)
+			return nullptr;
+		version_ = published_version;
+		return published_net;
+	}
+
+	/*!
+	 * Returns the number of training steps performed so far.
+	 */
+	long long getNumberOfTrainingSteps() {
+		return number_of_training_steps;
+	}
+
+private:
+	/*!
+	 * Main loop of the learner thread.
+	 */
+	void run() {
+		while (running) {
+			// Wait for experiences.
+			if (memory.size() < 2*batch_size) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				continue;
+			}//: if
+
+			float loss = trainOnRandomBatch();
+			LOG(LDEBUG) << "Learner training loss:" << loss;
+
+			number_of_training_steps++;
+			// Synchronize the target network.
+			if ((target_update_interval > 0) && (number_of_training_steps % (long long)target_update_interval == 0))
+				target_net = cloneNetwork(neural_net);
+			// Publish the network.
+			if (number_of_training_steps % (long long)publish_interval == 0)
+				publishNetwork();
+		}//: while
+	}
+
+	/*!
+	 * Performs a single Deep Q-learning step on a random batch of experiences.
+	 * @return Training loss.
+	 */
+	float trainOnRandomBatch() {
+		std::vector<mic::types::ObservationExperiencePtr> batch = memory.getRandomBatch(batch_size);
+		size_t input_size = batch[0]->o_t->rows();
+
+		// Create new matrices for batches of inputs and targets.
+		mic::types::MatrixXfPtr inputs_t_batch(new mic::types::MatrixXf(input_size, batch_size));
+		mic::types::MatrixXfPtr inputs_t_prim_batch(new mic::types::MatrixXf(input_size, batch_size));
+		mic::types::MatrixXfPtr targets_t_batch(new mic::types::MatrixXf(4, batch_size));
+
+		for (size_t i=0; i<batch_size; i++) {
+			inputs_t_batch->col(i) = batch[i]->o_t->col(0);
+			inputs_t_prim_batch->col(i) = batch[i]->o_t_prim->col(0);
+		}//: for
+
+		// Get network responses for states at time (t) and copy them to targets.
+		neural_net.forward(inputs_t_batch);
+		(*targets_t_batch) = (*neural_net.getPredictions());
+
+		// Get responses of the target network (if used) for states at time (t+n)...
+		mic::types::MatrixXfPtr target_predictions_t_prim_batch;
+		if (target_net) {
+			target_net->forward(inputs_t_prim_batch);
+			target_predictions_t_prim_batch = target_net->getPredictions();
+		}//: if
+
+		// ... and responses of the trained network (if required).
+		mic::types::MatrixXfPtr predictions_t_prim_batch;
+		if ((!target_net) || (double_dqn)) {
+			neural_net.forward(inputs_t_prim_batch);
+			predictions_t_prim_batch = neural_net.getPredictions();
+		}//: if
+
+		// Calculate the targets, one by one.
+		for (size_t i=0; i<batch_size; i++) {
+			mic::types::ObservationExperiencePtr exp = batch[i];
+			size_t a_t = (size_t)exp->a_t.getType();
+			if (exp->discount == 0.0f) {
+				// The chain has ended - learn the collected reward.
+				(*targets_t_batch)(a_t, i) = exp->reward;
+				continue;
+			}//: if
+
+			float max_q;
+			if (!target_net)
+				max_q = computeBestValue(exp->allowed_actions_t_prim, predictions_t_prim_batch->col(i).data());
+			else if (double_dqn)
+				max_q = computeDoubleQValue(exp->allowed_actions_t_prim, predictions_t_prim_batch->col(i).data(), target_predictions_t_prim_batch->col(i).data());
+			else
+				max_q = computeBestValue(exp->allowed_actions_t_prim, target_predictions_t_prim_batch->col(i).data());
+
+			if (std::isfinite(max_q))
+				(*targets_t_batch)(a_t, i) = exp->reward + exp->discount * max_q;
+		}//: for
+
+		// Train network with rewards.
+		return neural_net.train (inputs_t_batch, targets_t_batch, learning_rate, 0.0f);
+	}
+
+	/*!
+	 * Returns the best value among allowed actions.
+	 * @param allowed_ Mask of allowed actions.
+	 * @param predictions_ Vector of predictions.
+	 */
+	float computeBestValue(const bool* allowed_, const float* predictions_) {
+		float best_qvalue = -std::numeric_limits<float>::infinity();
+		for (size_t a=0; a<4; a++) {
+			if ((allowed_[a]) && (predictions_[a] > best_qvalue))
+				best_qvalue = predictions_[a];
+		}//: for
+		return best_qvalue;
+	}
+
+	/*!
+	 * Returns the Double DQN value: the best allowed action is selected with the trained network and evaluated with the target one.
+	 * @param allowed_ Mask of allowed actions.
+	 * @param predictions_ Vector of predictions of the trained network.
+	 * @param target_predictions_ Vector of predictions of the target network.
+	 */
+	float computeDoubleQValue(const bool* allowed_, const float* predictions_, const float* target_predictions_) {
+		float best_qvalue = -std::numeric_limits<float>::infinity();
+		float best_target_qvalue = -std::numeric_limits<float>::infinity();
+		for (size_t a=0; a<4; a++) {
+			if ((allowed_[a]) && (predictions_[a] > best_qvalue)) {
+				best_qvalue = predictions_[a];
+				best_target_qvalue = target_predictions_[a];
+			}//: if
+		}//: for
+		return best_target_qvalue;
+	}
+
+	/*!
+	 * Publishes a copy of the trained network.
+	 */
+	void publishNetwork() {
+		// Clone outside of the critical section.
+		std::shared_ptr<mic::mlnn::BackpropagationNeuralNetwork<float> > net = cloneNetwork(neural_net);
+		std::lock_guard<std::mutex> lock(publish_mutex);
+		published_net = net;
+		published_version++;
+	}
+
+	/// Trained network.
+	mic::mlnn::BackpropagationNeuralNetwork<float> & neural_net;
+
+	/// Target network (empty if not used).
+	std::shared_ptr<mic::mlnn::BackpropagationNeuralNetwork<float> > target_net;
+
+	/// Memory the experiences are sampled from.
+	mic::types::ObservationExperienceMemory & memory;
+
+	/// Size of the batch.
+	size_t batch_size;
+
+	/// Learning rate.
+	float learning_rate;
+
+	/// Number of training steps between synchronizations of the target network.
+	size_t target_update_interval;
+
+	/// Flag denoting whether the Double DQN targets are used.
+	bool double_dqn;
+
+	/// Number of training steps between publications of the network.
+	size_t publish_interval;
+
+	/// Flag denoting whether the learner thread should run.
+	std::atomic<bool> running;
+
+	/// Number of performed training steps.
+	std::atomic<long long> number_of_training_steps;
+
+	/// Learner thread.
+	std::thread learner_thread;
+
+	/// Mutex guarding the published network.
+	std::mutex publish_mutex;
+
+	/// Recently published network.
+	std::shared_ptr<mic::mlnn::BackpropagationNeuralNetwork<float> > published_net;
+
+	/// Version of the published network.
+	size_t published_version;
+};
+
+} /* namespace algorithms */
+} /* namespace mic */
+
+#endif /* SRC_ALGORITHMS_ASYNCDQNLEARNER_HPP_ */
@@ -0,0 +1,422 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file BanditPolicies.hpp
+ * \brief Contains declarations (and definitions) of the arm selection policies solving the n-armed bandit problem.
+ * \author tkornut
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_ALGORITHMS_BANDITPOLICIES_HPP_
+#define SRC_ALGORITHMS_BANDITPOLICIES_HPP_
+
+#include <vector>
+#include <random>
+#include <cmath>
+#include <cstdint>
+
+#include <configuration/PropertyTree.hpp>
+
+#include <types/Xoshiro256.hpp>
+#include <types/SoftmaxSampler.hpp>
+
+namespace mic {
+namespace algorithms {
+
+/*!
+ * \brief Base class of bandit policies: keeps the per-arm statistics (counts and sample-average values) and the generator.
+ * Every policy provides (non-virtual, so the calls can be inlined by the template applications) methods:
+ * initializePolicy(number_of_arms_, max_reward_), selectArm() and update(arm_, reward_).
+ * \author tkornuta
+ */
+class BanditPolicy : public mic::configuration::PropertyTree {
+public:
+	/*!
+	 * Constructor. Registers properties.
+	 * @param node_name_ Name of the node in configuration file.
+	 */
+	BanditPolicy(std::string node_name_) : PropertyTree(node_name_),
+		seed("seed", -1)
+	{
+		registerProperty(seed);
+	}
+
+	/*!
+	 * Initializes all variables that are property-dependent.
+	 */
+	virtual void initializePropertyDependentVariables() {
+		// Empty - everything will be initialized in initialization of the policy.
+	}
+
+	/*!
+	 * Seeds the generator and resets the statistics.
+	 * @param number_of_arms_ Number of arms.
+	 * @param max_reward_ Maximal (expected) reward - used by policies requiring rewards from [0,1].
+	 * @param initial_value_ Initial value of arms.
+	 */
+	void initializeStatistics(size_t number_of_arms_, float max_reward_, float initial_value_ = 0.0f) {
+		uint64_t s = (seed < 0) ? ((uint64_t)std::random_device()() << 32) ^ std::random_device()() : (uint64_t)seed;
+		rng.seed(s);
+		number_of_arms = number_of_arms_;
+		inv_max_reward = (max_reward_ > 0) ? 1.0f / max_reward_ : 1.0f;
+		counts.assign(number_of_arms, 0);
+		values.assign(number_of_arms, initial_value_);
+	}
+
+	/// Returns the (sample-average) value of the arm.
+	inline float getValue(size_t arm_) { return values[arm_]; }
+
+	/// Returns the number of pulls of the arm.
+	inline uint32_t getCount(size_t arm_) { return counts[arm_]; }
+
+protected:
+	/*!
+	 * Updates the statistics of the arm (incremental sample average).
+	 * @param arm_ Index of the arm.
+	 * @param reward_ Received reward.
+	 */
+	inline void updateStatistics(size_t arm_, float reward_) {
+		uint32_t n = ++counts[arm_];
+		values[arm_] += (reward_ - values[arm_]) / n;
+	}
+
+	/// Returns the index of the arm with the greatest value (ties resolved in favour of the lower index).
+	inline size_t greedyArm() {
+		size_t best = 0;
+		for (size_t i=1; i<number_of_arms; i++)
+			best = (values[i] > values[best]) ? i : best;
+		return best;
+	}
+
+	/// Returns a random real from [0,1).
+	inline float uniform() {
+		return (float)(rng() >> 40) * (1.0f / 16777216.0f);
+	}
+
+	/// Returns a random integer from [0, n_).
+	inline size_t uniformInt(size_t n_) {
+		return (size_t)(((rng() >> 32) * (uint64_t)n_) >> 32);
+	}
+
+	/*!
+	 * Property: seed of the generator.
+	 * Setting seed < 0 means that the generator will be seeded by std::random_device.
+	 */
+	mic::configuration::Property<long> seed;
+
+	/// Generator of the policy.
+	mic::types::Xoshiro256 rng;
+
+	/// Number of arms.
+	size_t number_of_arms;
+
+	/// Inverse of the maximal reward.
+	float inv_max_reward;
+
+	/// Counts of pulls of arms.
+	std::vector<uint32_t> counts;
+
+	/// Sample-average values of arms.
+	std::vector<float> values;
+};
+
+
+/*!
+ * \brief Epsilon-greedy policy: the arm with the greatest sample-average value, a random arm with probability epsilon.
+ * \author tkornuta
+ */
+class EpsilonGreedyBanditPolicy : public BanditPolicy {
+public:
+	/*!
+	 * Constructor. Registers properties.
+	 * @param node_name_ Name of the node in configuration file.
+	 */
+	EpsilonGreedyBanditPolicy(std::string node_name_ = "policy") : BanditPolicy(node_name_),
+		epsilon("epsilon", 0.1),
+		initial_value("initial_value", 0.0)
+	{
+		registerProperty(epsilon);
+		registerProperty(initial_value);
+	}
+
+	/*!
+	 * Initializes the policy.
+	 * @param number_of_arms_ Number of arms.
+	 * @param max_reward_ Maximal (expected) reward.
+	 */
+	void initializePolicy(size_t number_of_arms_, float max_reward_) {
+		initializeStatistics(number_of_arms_, max_reward_, initial_value);
+	}
+
+	/// Selects the arm.
+	inline size_t selectArm() {
+		if (uniform() < (float)epsilon)
+			return uniformInt(number_of_arms);
+		return greedyArm();
+	}
+
+	/// Updates the policy with the received reward.
+	inline void update(size_t arm_, float reward_) {
+		updateStatistics(arm_, reward_);
+	}
+
+private:
+	/// Property: probability of selection of a random arm.
+	mic::configuration::Property<double> epsilon;
+
+	/// Property: initial values of arms (values greater than the rewards result in the "optimistic" exploration).
+	mic::configuration::Property<float> initial_value;
+};
+
+
+/*!
+ * \brief Softmax (Boltzmann) policy: arms are sampled with probabilities proportional to exp(value/tau).
+ * The distribution is kept in a sum-tree, so both the selection and the update are O(log n).
+ * \author tkornuta
+ */
+class SoftmaxBanditPolicy : public BanditPolicy {
+public:
+	/*!
+	 * Constructor. Registers properties.
+	 * @param node_name_ Name of the node in configuration file.
+	 */
+	SoftmaxBanditPolicy(std::string node_name_ = "policy") : BanditPolicy(node_name_),
+		tau("tau", 1.0)
+	{
+		registerProperty(tau);
+	}
+
+	/*!
+	 * Initializes the policy.
+	 * @param number_of_arms_ Number of arms.
+	 * @param max_reward_ Maximal (expected) reward.
+	 */
+	void initializePolicy(size_t number_of_arms_, float max_reward_) {
+		initializeStatistics(number_of_arms_, max_reward_);
+		softmax.initialize(number_of_arms_, tau, 0.0f);
+	}
+
+	/// Selects the arm.
+	inline size_t selectArm() {
+		return softmax.sample(uniform());
+	}
+
+	/// Updates the policy with the received reward - only the weight of the pulled arm changes.
+	inline void update(size_t arm_, float reward_) {
+		updateStatistics(arm_, reward_);
+		softmax.setValue(arm_, values[arm_]);
+	}
+
+private:
+	/*!
+	 * Property: the softmax "heat" parameter, scaling the probability distribution of all actions.
+	 * A high temperature will tend the probabilities to be very similar, whereas a low temperature will exaggerate differences in probabilities between actions.
+	 */
+	mic::configuration::Property<double> tau;
+
+	/// Softmax distribution over the values of arms.
+	mic::types::SoftmaxSampler softmax;
+};
+
+
+/*!
+ * \brief UCB1 policy (Auer et al.): every arm is pulled once, then the arm maximizing mean + sqrt(2 ln t / n_i) is selected
+ * (the means are normalized to [0,1] by the maximal reward).
+ * The bonus is computed as sqrt(ln t) * sqrt(2 / n_i): the first factor is cached once per pull, the second one per arm
+ * (it changes only when the arm is pulled), so the selection needs a single multiply-add per arm.
+ * \author tkornuta
+ */
+class UCB1BanditPolicy : public BanditPolicy {
+public:
+	/*!
+	 * Constructor. Registers properties.
+	 * @param node_name_ Name of the node in configuration file.
+	 */
+	UCB1BanditPolicy(std::string node_name_ = "policy") : BanditPolicy(node_name_),
+		exploration("exploration", 1.0)
+	{
+		registerProperty(exploration);
+	}
+
+	/*!
+	 * Initializes the policy.
+	 * @param number_of_arms_ Number of arms.
+	 * @param max_reward_ Maximal (expected) reward.
+	 */
+	void initializePolicy(size_t number_of_arms_, float max_reward_) {
+		initializeStatistics(number_of_arms_, max_reward_);
+		arm_bonuses.assign(number_of_arms_, 0.0f);
+		number_of_pulls = 0;
+		sqrt_log_pulls = 0.0f;
+	}
+
+	/// Selects the arm.
+	inline size_t selectArm() {
+		// Pull every arm once (in order).
+		if (number_of_pulls < number_of_arms)
+			return number_of_pulls;
+
+		size_t best = 0;
+		float best_score = values[0] * inv_max_reward + sqrt_log_pulls * arm_bonuses[0];
+		for (size_t i=1; i<number_of_arms; i++) {
+			float score = values[i] * inv_max_reward + sqrt_log_pulls * arm_bonuses[i];
+			bool better = score > best_score;
+			best_score = better ? score : best_score;
+			best = better ? i : best;
+		}//: for
+		return best;
+	}
+
+	/// Updates the policy with the received reward.
+	inline void update(size_t arm_, float reward_) {
+		updateStatistics(arm_, reward_);
+		arm_bonuses[arm_] = (float)exploration * std::sqrt(2.0f / counts[arm_]);
+		number_of_pulls++;
+		sqrt_log_pulls = std::sqrt(std::log((float)number_of_pulls));
+	}
+
+private:
+	/// Property: multiplier of the exploration bonus (1 for the original UCB1).
+	mic::configuration::Property<double> exploration;
+
+	/// Cached per-arm factors of the bonus: exploration * sqrt(2 / n_i).
+	std::vector<float> arm_bonuses;
+
+	/// Total number of pulls.
+	size_t number_of_pulls;
+
+	/// Cached sqrt(ln(number_of_pulls)).
+	float sqrt_log_pulls;
+};
+
+
+/*!
+ * \brief Thompson sampling with Beta-Bernoulli model: the arm with the greatest sample from the Beta posterior of its success
+ * probability is selected. Rewards are normalized to [0,1] by the maximal reward and added as fractional successes/failures
+ * to the Beta(1,1) prior. Beta samples are ratios of gamma samples drawn with the Marsaglia-Tsang method, whose per-arm
+ * constants are cached and recomputed only when the arm is pulled.
+ * \author tkornuta
+ */
+class ThompsonSamplingBanditPolicy : public BanditPolicy {
+public:
+	/*!
+	 * Constructor.
+	 * @param node_name_ Name of the node in configuration file.
+	 */
+	ThompsonSamplingBanditPolicy(std::string node_name_ = "policy") : BanditPolicy(node_name_) { }
+
+	/*!
+	 * Initializes the policy.
+	 * @param number_of_arms_ Number of arms.
+	 * @param max_reward_ Maximal (expected) reward.
+	 */
+	void initializePolicy(size_t number_of_arms_, float max_reward_) {
+		initializeStatistics(number_of_arms_, max_reward_);
+		normal.reset();
+		alphas.assign(number_of_arms_, GammaParameters());
+		betas.assign(number_of_arms_, GammaParameters());
+		for (size_t i=0; i<number_of_arms_; i++) {
+			alphas[i].setShape(1.0);
+			betas[i].setShape(1.0);
+		}//: for
+	}
+
+	/// Selects the arm.
+	inline size_t selectArm() {
+		size_t best = 0;
+		float best_sample = -1.0f;
+		for (size_t i=0; i<number_of_arms; i++) {
+			float x = sampleGamma(alphas[i]);
+			float y = sampleGamma(betas[i]);
+			float sample = x / (x + y);
+			if (sample > best_sample) {
+				best_sample = sample;
+				best = i;
+			}//: if
+		}//: for
+		return best;
+	}
+
+	/// Updates the policy with the received reward.
+	inline void update(size_t arm_, float reward_) {
+		updateStatistics(arm_, reward_);
+		float x = reward_ * inv_max_reward;
+		x = (x < 0.0f) ? 0.0f : ((x > 1.0f) ? 1.0f : x);
+		alphas[arm_].setShape(alphas[arm_].shape + x);
+		betas[arm_].setShape(betas[arm_].shape + (1.0f - x));
+	}
+
+private:
+	/*!
+	 * \brief Shape of the gamma distribution with the cached constants of the Marsaglia-Tsang method (valid for shape >= 1,
+	 * which always holds here, as the prior is Beta(1,1) and the shapes only grow).
+	 * The shape accumulates the rewards over the whole run, so it is stored in double - in float the small increments
+	 * would be lost once the shape grows large. Only the constants used in sampling are kept in float.
+	 */
+	struct GammaParameters {
+		/// Shape.
+		double shape;
+		/// d = shape - 1/3.
+		float d;
+		/// c = 1 / sqrt(9d).
+		float c;
+
+		/// Sets the shape and recomputes the constants.
+		void setShape(double shape_) {
+			shape = shape_;
+			double d_ = shape_ - 1.0 / 3.0;
+			d = (float)d_;
+			c = (float)(1.0 / std::sqrt(9.0 * d_));
+		}
+	};
+
+	/*!
+	 * Samples the gamma distribution (with unit scale) - the Marsaglia-Tsang method.
+	 * @param params_ Parameters of the distribution.
+	 */
+	inline float sampleGamma(const GammaParameters & params_) {
+		while (true) {
+			float x, v;
+			do {
+				x = normal(rng);
+				v = 1.0f + params_.c * x;
+			} while (v <= 0.0f);
+			v = v * v * v;
+			// u from (0,1) - log(u) must be finite.
+			float u = ((float)(rng() >> 40) + 0.5f) * (1.0f / 16777216.0f);
+			float x2 = x * x;
+			// Fast acceptance (squeeze), then the exact test.
+			if (u < 1.0f - 0.0331f * x2 * x2)
+				return params_.d * v;
+			if (std::log(u) < 0.5f * x2 + params_.d * (1.0f - v + std::log(v)))
+				return params_.d * v;
+		}//: while
+	}
+
+	/// Standard normal distribution.
+	std::normal_distribution<float> normal;
+
+	/// Parameters of the gamma distributions of successes.
+	std::vector<GammaParameters> alphas;
+
+	/// Parameters of the gamma distributions of failures.
+	std::vector<GammaParameters> betas;
+};
+
+} /* namespace algorithms */
+} /* namespace mic */
+
+#endif /* SRC_ALGORITHMS_BANDITPOLICIES_HPP_ */
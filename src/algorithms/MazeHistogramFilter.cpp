@@ -21,6 +21,7 @@
  */
 
 #include <algorithms/MazeHistogramFilter.hpp>
+#include <application/Trace.hpp>
 
 #include <utils/DataCollector.hpp>
 
@@ -334,16 +335,16 @@ mic::types::Action2DInterface MazeHistogramFilter::mostUniquePatchActionSelectio
 					size_t new_x = (x + maze_width + ac.dx) % maze_width;
 					// Get image patch.
 					short patch = (*mazes[m])(new_y, new_x);
-					LOG(LDEBUG) << "maze [" << m << "] (y=" << y <<",x="<< x <<") move="<< act_t << "=> (y+dy=" << new_y << ",x+dx=" << new_x <<") patch=" << patch << std::endl;
+					TRACE(TRACE_DUMP, LDEBUG) << "maze [" << m << "] (y=" << y <<",x="<< x <<") move="<< act_t << "=> (y+dy=" << new_y << ",x+dx=" << new_x <<") patch=" << patch << std::endl;
 					// Get patch probability.
 					double patch_prob = maze_patch_probabilities[patch];
 					// Check the action utility.
 					double action_utility = (*maze_position_probabilities[m])(new_y, new_x) * (1- patch_prob);
-					LOG(LDEBUG) << "patch_prob= " << patch_prob << " action_utility=" << action_utility << std::endl;
+					TRACE(TRACE_DUMP, LDEBUG) << "patch_prob= " << patch_prob << " action_utility=" << action_utility << std::endl;
 					if (action_utility > best_action_utility) {
 						best_action_utility = action_utility;
 						best_action = act_t;
-						LOG(LDEBUG) << "found action " << best_action << " with biggest utility " << best_action_utility << std::endl;
+						TRACE(TRACE_STEP, LDEBUG) << "found action " << best_action << " with biggest utility " << best_action_utility << std::endl;
 					}
 				}//: for j
 			}//: for i
@@ -376,12 +377,12 @@ mic::types::Action2DInterface MazeHistogramFilter::sumOfMostUniquePatchesActionS
 					size_t new_x = (x + maze_width + ac.dx) % maze_width;
 					// Get image patch.
 					short patch = (*mazes[m])(new_y, new_x);
-					LOG(LDEBUG) << "maze [" << m << "] (y=" << y <<",x="<< x <<") move="<< act_t << "=> (y+dy=" << new_y << ",x+dx=" << new_x <<") patch=" << patch << std::endl;
+					TRACE(TRACE_DUMP, LDEBUG) << "maze [" << m << "] (y=" << y <<",x="<< x <<") move="<< act_t << "=> (y+dy=" << new_y << ",x+dx=" << new_x <<") patch=" << patch << std::endl;
 					// Get patch probability.
 					double patch_prob = maze_patch_probabilities[patch];
 					// Check the action result.
 					double tmp_action_utility = (*maze_position_probabilities[m])(new_y, new_x) * (1- patch_prob);
-					LOG(LDEBUG) << "patch_prob= " << patch_prob << " action_utility=" << tmp_action_utility << std::endl;
+					TRACE(TRACE_DUMP, LDEBUG) << "patch_prob= " << patch_prob << " action_utility=" << tmp_action_utility << std::endl;
 
 					// Add action utility.
 					action_utilities(act_t) += tmp_action_utility;
@@ -398,7 +399,7 @@ mic::types::Action2DInterface MazeHistogramFilter::sumOfMostUniquePatchesActionS
 		if (action_utilities(act_t) > best_action_utility) {
 			best_action_utility = action_utilities(act_t);
 			best_action = act_t;
-			LOG(LDEBUG) << "found action " << best_action << " with biggest utility " << best_action_utility << std::endl;
+			TRACE(TRACE_STEP, LDEBUG) << "found action " << best_action << " with biggest utility " << best_action_utility << std::endl;
 		}
 
 	}//: for each action type
@@ -0,0 +1,62 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file NetworkCloning.hpp
+ * \brief Contains a function creating deep copies of neural networks (used e.g. as target networks in DQN).
+ * \author tkornut
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_ALGORITHMS_NETWORKCLONING_HPP_
+#define SRC_ALGORITHMS_NETWORKCLONING_HPP_
+
+#include <sstream>
+#include <memory>
+
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/archive/text_iarchive.hpp>
+
+#include <mlnn/BackpropagationNeuralNetwork.hpp>
+
+namespace mic {
+namespace algorithms {
+
+/*!
+ * Creates a deep copy of the neural network (layers along with their parameters).
+ * The copy is made by serializing the network into an in-memory archive and deserializing it into a fresh object,
+ * so the returned network does not share any layers/matrices with the original one.
+ * @param src_ Network to be cloned.
+ * @return Shared pointer to the cloned network.
+ */
+template <typename eT>
+std::shared_ptr<mic::mlnn::BackpropagationNeuralNetwork<eT> > cloneNetwork(const mic::mlnn::BackpropagationNeuralNetwork<eT> & src_) {
+	std::stringstream ss;
+	{
+		// Archive must be destroyed (flushed) before reading.
+		boost::archive::text_oarchive oa(ss);
+		oa << src_;
+	}
+	std::shared_ptr<mic::mlnn::BackpropagationNeuralNetwork<eT> > dst (new mic::mlnn::BackpropagationNeuralNetwork<eT>());
+	boost::archive::text_iarchive ia(ss);
+	ia >> (*dst);
+
+	return dst;
+}
+
+} /* namespace algorithms */
+} /* namespace mic */
+
+#endif /* SRC_ALGORITHMS_NETWORKCLONING_HPP_ */
@@ -0,0 +1,263 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file DRLPolicyEvaluation.hpp
+ * \brief Contains declaration (and definition) of the headless application evaluating trained DRL policies in parallel.
+ * \author tkornut
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_APPLICATION_DRLPOLICYEVALUATION_HPP_
+#define SRC_APPLICATION_DRLPOLICYEVALUATION_HPP_
+
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <limits>
+
+#include <application/Application.hpp>
+
+#include <mlnn/BackpropagationNeuralNetwork.hpp>
+#include <algorithms/NetworkCloning.hpp>
+
+#include <types/Position2D.hpp>
+
+namespace mic {
+namespace application {
+
+/*!
+ * \brief Headless application evaluating the greedy policy of a trained (serialized) network.
+ * The episodes (environment instances) are generated in the main thread and evaluated by a pool of worker threads,
+ * each working on a deep copy of the environment and its own copy of the network.
+ * Reports the success ratio, path lengths versus the optimal ones and the number of steps per second.
+ * \author tkornuta
+ * \tparam EnvironmentType Type of the environment (Gridworld, MazeOfDigits or MNISTDigit).
+ */
+template <class EnvironmentType>
+class DRLPolicyEvaluation: public mic::application::Application {
+public:
+	/*!
+	 * Default Constructor. Sets the application/node name, default values of variables etc.
+	 * @param node_name_ Name of the application/node (in configuration file).
+	 */
+	DRLPolicyEvaluation(std::string node_name_ = "application") : Application(node_name_),
+		mlnn_filename("mlnn_filename", "mlnn.txt"),
+		number_of_episodes("number_of_episodes", 1000),
+		number_of_threads("number_of_threads", 0),
+		step_limit("step_limit", 100),
+		network_loaded(false)
+	{
+		// Register properties - so their values can be overridden (read from the configuration file).
+		registerProperty(mlnn_filename);
+		registerProperty(number_of_episodes);
+		registerProperty(number_of_threads);
+		registerProperty(step_limit);
+
+		LOG(LINFO) << "Properties registered";
+	}
+
+	/*!
+	 * Destructor.
+	 */
+	virtual ~DRLPolicyEvaluation() { }
+
+protected:
+	/*!
+	 * Initializes all variables that are property-dependent - loads the network.
+	 */
+	virtual void initializePropertyDependentVariables() {
+		// Initialize the environment (so the sizes are known).
+		env.initializeEnvironment();
+
+		network_loaded = neural_net.load(mlnn_filename);
+		if (!network_loaded)
+			LOG(LERROR) << "Could not load the neural network from " << (std::string)mlnn_filename;
+	}
+
+	/*!
+	 * Method empty (not used).
+	 * @param argc Number of application parameters.
+	 * @param argv Array of application parameters.
+	 */
+	virtual void initialize(int argc, char* argv[]) { }
+
+	/*!
+	 * Performs the whole evaluation.
+	 */
+	virtual bool performSingleStep() {
+		// Do not report statistics of an empty network.
+		if (!network_loaded) {
+			LOG(LERROR) << "Evaluation aborted - the neural network was not loaded";
+			return false;
+		}//: if
+
+		size_t threads = (number_of_threads > 0) ? (size_t)number_of_threads : std::thread::hardware_concurrency();
+		if (threads == 0)
+			threads = 1;
+
+		// Generate the episodes in the main thread (the random generator is not thread-safe).
+		std::vector<std::shared_ptr<EnvironmentType> > episodes;
+		for (size_t e=0; e<number_of_episodes; e++) {
+			env.initializeEnvironment();
+			episodes.push_back(std::make_shared<EnvironmentType>(env));
+		}//: for
+
+		// Prepare network copies, processing single observations.
+		std::vector<std::shared_ptr<mic::mlnn::BackpropagationNeuralNetwork<float> > > nets;
+		for (size_t t=0; t<threads; t++) {
+			nets.push_back(mic::algorithms::cloneNetwork(neural_net));
+			nets.back()->resizeBatch(1);
+		}//: for
+
+		LOG(LSTATUS) << "Evaluating " << (std::string)mlnn_filename << " on " << number_of_episodes << " episodes using " << threads << " threads";
+
+		std::vector<EpisodeStatistics> stats(threads);
+		std::atomic<size_t> next_episode(0);
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+		// Start the workers.
+		std::vector<std::thread> workers;
+		for (size_t t=0; t<threads; t++) {
+			workers.push_back(std::thread([&, t]() {
+				size_t e;
+				while ((e = next_episode++) < episodes.size())
+					evaluateEpisode(*episodes[e], *nets[t], stats[t]);
+			}));
+		}//: for
+		for (std::thread & worker : workers)
+			worker.join();
+
+		std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+		// Reduce the statistics.
+		EpisodeStatistics total;
+		for (EpisodeStatistics & s : stats)
+			total.add(s);
+
+		LOG(LSTATUS) << "Success ratio = " << (float)total.successes / number_of_episodes
+				<< " (" << total.successes << "/" << number_of_episodes << ")";
+		if (total.successes > 0)
+			LOG(LSTATUS) << "Average path length = " << (float)total.path_lengths / total.successes
+				<< " (optimal = " << (float)total.optimal_path_lengths / total.successes
+				<< ", average optimal to episodic path length ratio = " << total.opt_to_episodic / total.successes << ")";
+		LOG(LSTATUS) << "Steps = " << total.steps << ", time = " << elapsed.count() << "s, steps/sec = " << total.steps / elapsed.count();
+
+		// Evaluation is done.
+		return false;
+	}
+
+private:
+	/*!
+	 * \brief Statistics collected by a single worker.
+	 */
+	struct EpisodeStatistics {
+		/// Number of successful episodes (goal reached).
+		size_t successes = 0;
+
+		/// Total number of performed steps.
+		size_t steps = 0;
+
+		/// Sum of path lengths of successful episodes.
+		size_t path_lengths = 0;
+
+		/// Sum of optimal path lengths of successful episodes.
+		size_t optimal_path_lengths = 0;
+
+		/// Sum of optimal to episodic path length ratios of successful episodes.
+		double opt_to_episodic = 0;
+
+		/// Accumulates the statistics of other worker.
+		void add(const EpisodeStatistics & s_) {
+			successes += s_.successes;
+			steps += s_.steps;
+			path_lengths += s_.path_lengths;
+			optimal_path_lengths += s_.optimal_path_lengths;
+			opt_to_episodic += s_.opt_to_episodic;
+		}
+	};
+
+	/*!
+	 * Runs a single greedy episode - called by worker threads (must not use the shared state of the application).
+	 * @param env_ Environment (episode) to be evaluated.
+	 * @param net_ Network used by the worker.
+	 * @param stats_ Statistics of the worker.
+	 */
+	void evaluateEpisode(EnvironmentType & env_, mic::mlnn::BackpropagationNeuralNetwork<float> & net_, EpisodeStatistics & stats_) {
+		unsigned int optimal = env_.optimalPathLength();
+		size_t steps = 0;
+		mic::types::Position2D pos = env_.getAgentPosition();
+
+		while ((!env_.isStateTerminal(pos)) && ((step_limit <= 0) || (steps < (size_t)step_limit))) {
+			// Get predictions for the current observation.
+			net_.forward(env_.encodeObservation());
+			float* pred = net_.getPredictions()->data();
+
+			// Select the best allowed action.
+			float best_qvalue = -std::numeric_limits<float>::infinity();
+			long best_action = -1;
+			for(size_t a=0; a<4; a++) {
+				if ((env_.isActionAllowed(pos, mic::types::NESWAction((mic::types::NESW)a))) && (pred[a] > best_qvalue)) {
+					best_qvalue = pred[a];
+					best_action = a;
+				}//: if
+			}//: for
+			if (best_action < 0)
+				break;
+
+			env_.moveAgent(mic::types::NESWAction((mic::types::NESW)best_action));
+			pos = env_.getAgentPosition();
+			steps++;
+		}//: while
+
+		stats_.steps += steps;
+		if ((env_.isStateTerminal(pos)) && (env_.getStateReward(pos) > 0)) {
+			stats_.successes++;
+			stats_.path_lengths += steps;
+			stats_.optimal_path_lengths += optimal;
+			if (steps > 0)
+				stats_.opt_to_episodic += (double)optimal / steps;
+		}//: if
+	}
+
+	/// The environment used for generation of episodes.
+	EnvironmentType env;
+
+	/// Evaluated network.
+	mic::mlnn::BackpropagationNeuralNetwork<float> neural_net;
+
+	/// Property: name of the file the neural network will be deserialized from.
+	mic::configuration::Property<std::string> mlnn_filename;
+
+	/// Property: number of evaluated episodes.
+	mic::configuration::Property<size_t> number_of_episodes;
+
+	/// Property: number of worker threads (0 means the number of hardware threads).
+	mic::configuration::Property<size_t> number_of_threads;
+
+	/// Property: limit of steps for episode. Setting step_limit <= 0 means that the limit should not be considered.
+	mic::configuration::Property<int> step_limit;
+
+	/// Flag denoting whether the network was successfully loaded (the evaluation is aborted otherwise).
+	bool network_loaded;
+};
+
+
+} /* namespace application */
+} /* namespace mic */
+
+#endif /* SRC_APPLICATION_DRLPOLICYEVALUATION_HPP_ */
@@ -0,0 +1,141 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file ExperienceMemoryBenchmark.cpp
+ * \brief Definitions of the methods of the application measuring insert throughput of the concurrent experience memory.
+ * \author tkornut
+ * \date Oct 18, 2026
+ */
+
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+#include <application/ExperienceMemoryBenchmark.hpp>
+
+namespace mic {
+namespace application {
+
+/*!
+ * \brief Registers the application.
+ * \author tkornuta
+ */
+void RegisterApplication (void) {
+	REGISTER_APPLICATION(mic::application::ExperienceMemoryBenchmark);
+}
+
+
+ExperienceMemoryBenchmark::ExperienceMemoryBenchmark(std::string node_name_) : Application(node_name_),
+		number_of_experiences("number_of_experiences", 100000),
+		number_of_shards("number_of_shards", 16),
+		inserts_per_producer("inserts_per_producer", 100000),
+		max_producers("max_producers", 32),
+		batch_size("batch_size", 32),
+		concurrent_sampling("concurrent_sampling", true)
+	{
+	// Register properties - so their values can be overridden (read from the configuration file).
+	registerProperty(number_of_experiences);
+	registerProperty(number_of_shards);
+	registerProperty(inserts_per_producer);
+	registerProperty(max_producers);
+	registerProperty(batch_size);
+	registerProperty(concurrent_sampling);
+
+	LOG(LINFO) << "Properties registered";
+}
+
+
+ExperienceMemoryBenchmark::~ExperienceMemoryBenchmark() {
+
+}
+
+
+void ExperienceMemoryBenchmark::initialize(int argc, char* argv[]) {
+
+}
+
+
+void ExperienceMemoryBenchmark::initializePropertyDependentVariables() {
+	number_of_producers = 1;
+	LOG(LSTATUS) << "Producers | Inserts/s (" << number_of_shards << " shards) | Inserts/s (single lock)";
+}
+
+
+double ExperienceMemoryBenchmark::measureThroughput(size_t number_of_producers_, size_t number_of_shards_) {
+	mic::types::ConcurrentExperienceMemory<mic::types::SpatialExperience> memory(number_of_experiences, number_of_shards_);
+
+	// Prepare experiences before the measurement - every producer cycles through its own pool.
+	const size_t pool_size = 1024;
+	std::vector<std::vector<mic::types::SpatialExperiencePtr> > pools(number_of_producers_);
+	for (size_t p=0; p<number_of_producers_; p++)
+		for (size_t i=0; i<pool_size; i++)
+			pools[p].push_back(std::make_shared<mic::types::SpatialExperience>(mic::types::Position2D(i,p), A_NORTH, mic::types::Position2D(i,p+1)));
+
+	std::atomic<bool> producing(true);
+	std::atomic<size_t> sampled_batches(0);
+
+	// Start the consumer.
+	std::thread consumer;
+	if (concurrent_sampling) {
+		consumer = std::thread([&]() {
+			while (producing) {
+				if (memory.getRandomBatch(batch_size).size() > 0)
+					sampled_batches++;
+			}//: while
+		});
+	}//: if
+
+	// Start the producers.
+	std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+	std::vector<std::thread> producers;
+	for (size_t p=0; p<number_of_producers_; p++) {
+		producers.push_back(std::thread([&, p]() {
+			for (size_t i=0; i<inserts_per_producer; i++)
+				memory.add(pools[p][i % pool_size]);
+		}));
+	}//: for
+
+	for (std::thread & producer : producers)
+		producer.join();
+	std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+	producing = false;
+	if (consumer.joinable())
+		consumer.join();
+
+	LOG(LINFO) << number_of_producers_ << " producers, " << number_of_shards_ << " shards: " << elapsed.count() << "s, " << sampled_batches << " batches sampled, memory size = " << memory.size();
+
+	return (double)(number_of_producers_ * inserts_per_producer) / elapsed.count();
+}
+
+
+bool ExperienceMemoryBenchmark::performSingleStep() {
+	LOG(LTRACE) << "Performing a single step (" << iteration << ")";
+
+	if (number_of_producers > max_producers)
+		return false;
+
+	double sharded = measureThroughput(number_of_producers, number_of_shards);
+	double single = measureThroughput(number_of_producers, 1);
+	LOG(LSTATUS) << number_of_producers << " | " << sharded << " | " << single;
+
+	number_of_producers *= 2;
+	return true;
+}
+
+
+} /* namespace application */
+} /* namespace mic */
@@ -0,0 +1,110 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file ExperienceMemoryBenchmark.hpp
+ * \brief Contains declaration of the application measuring insert throughput of the concurrent experience memory.
+ * \author tkornut
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_APPLICATION_EXPERIENCEMEMORYBENCHMARK_HPP_
+#define SRC_APPLICATION_EXPERIENCEMEMORYBENCHMARK_HPP_
+
+#include <vector>
+#include <string>
+
+#include <application/Application.hpp>
+
+#include <types/SpatialExperienceMemory.hpp>
+#include <types/ConcurrentExperienceMemory.hpp>
+
+namespace mic {
+namespace application {
+
+/*!
+ * \brief Application measuring the insert throughput of the concurrent (sharded) experience memory under a growing number of producer threads.
+ * In every step the number of producers is doubled (1, 2, 4, ... max_producers) and the throughput of the sharded memory
+ * is compared with the memory with a single shard (i.e. guarded by a single mutex).
+ * Optionally a consumer thread samples random batches during the inserts.
+ * \author tkornuta
+ */
+class ExperienceMemoryBenchmark: public mic::application::Application {
+public:
+	/*!
+	 * Default Constructor. Sets the application/node name, default values of variables etc.
+	 * @param node_name_ Name of the application/node (in configuration file).
+	 */
+	ExperienceMemoryBenchmark(std::string node_name_ = "application");
+
+	/*!
+	 * Destructor.
+	 */
+	virtual ~ExperienceMemoryBenchmark();
+
+protected:
+	/*!
+	 * Initializes all variables that are property-dependent.
+	 */
+	virtual void initializePropertyDependentVariables();
+
+	/*!
+	 * Method empty (not used).
+	 * @param argc Number of application parameters.
+	 * @param argv Array of application parameters.
+	 */
+	virtual void initialize(int argc, char* argv[]);
+
+	/*!
+	 * Performs the benchmark for the current number of producers.
+	 */
+	virtual bool performSingleStep();
+
+private:
+
+	/*!
+	 * Measures the insert throughput.
+	 * @param number_of_producers_ Number of producer threads.
+	 * @param number_of_shards_ Number of shards of the tested memory.
+	 * @return Number of inserts per second.
+	 */
+	double measureThroughput(size_t number_of_producers_, size_t number_of_shards_);
+
+	/// Property: capacity of the tested memory.
+	mic::configuration::Property<size_t> number_of_experiences;
+
+	/// Property: number of shards of the tested memory.
+	mic::configuration::Property<size_t> number_of_shards;
+
+	/// Property: number of inserts performed by every producer.
+	mic::configuration::Property<size_t> inserts_per_producer;
+
+	/// Property: maximal number of producer threads.
+	mic::configuration::Property<size_t> max_producers;
+
+	/// Property: size of the batch sampled by the consumer.
+	mic::configuration::Property<size_t> batch_size;
+
+	/// Property: flag denoting whether the consumer should sample the memory during the inserts.
+	mic::configuration::Property<bool> concurrent_sampling;
+
+	/// Current number of producers.
+	size_t number_of_producers;
+};
+
+} /* namespace application */
+} /* namespace mic */
+
+#endif /* SRC_APPLICATION_EXPERIENCEMEMORYBENCHMARK_HPP_ */
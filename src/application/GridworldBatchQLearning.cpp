@@ -0,0 +1,264 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file GridworldBatchQLearning.cpp
+ * \brief Definitions of the methods of the application running many independent tabular Q-learning agents in lockstep.
+ * \author tkornut
+ * \date Oct 18, 2026
+ */
+
+#include <limits>
+#include <random>
+#include <chrono>
+#include <fstream>
+
+#include <application/GridworldBatchQLearning.hpp>
+#include <types/Xoshiro256.hpp>
+
+namespace mic {
+namespace application {
+
+/*!
+ * \brief Registers the application.
+ * \author tkornuta
+ */
+void RegisterApplication (void) {
+	REGISTER_APPLICATION(mic::application::GridworldBatchQLearning);
+}
+
+
+GridworldBatchQLearning::GridworldBatchQLearning(std::string node_name_) : Application(node_name_),
+		number_of_agents("number_of_agents", 1024),
+		number_of_steps("number_of_steps", 100000),
+		step_reward("step_reward", 0.0),
+		discount_rate("discount_rate", 0.9),
+		learning_rate_min("learning_rate_min", 0.1),
+		learning_rate_max("learning_rate_max", 0.1),
+		epsilon("epsilon", 0.1),
+		step_limit("step_limit", 100),
+		seed("seed", -1),
+		statistics_filename("statistics_filename","statistics_filename.csv")
+	{
+	// Register properties - so their values can be overridden (read from the configuration file).
+	registerProperty(number_of_agents);
+	registerProperty(number_of_steps);
+	registerProperty(step_reward);
+	registerProperty(discount_rate);
+	registerProperty(learning_rate_min);
+	registerProperty(learning_rate_max);
+	registerProperty(epsilon);
+	registerProperty(step_limit);
+	registerProperty(seed);
+	registerProperty(statistics_filename);
+
+	LOG(LINFO) << "Properties registered";
+}
+
+
+GridworldBatchQLearning::~GridworldBatchQLearning() {
+
+}
+
+
+void GridworldBatchQLearning::initialize(int argc, char* argv[]) {
+
+}
+
+
+void GridworldBatchQLearning::initializePropertyDependentVariables() {
+	// Generate the first gridworld - so the size is known.
+	grid_env.initializeEnvironment();
+	size_t width = grid_env.getEnvironmentWidth();
+	number_of_states = width * grid_env.getEnvironmentHeight();
+	state_deltas[0] = -(int32_t)width;
+	state_deltas[1] = 1;
+	state_deltas[2] = (int32_t)width;
+	state_deltas[3] = -1;
+
+	action_masks.resize(number_of_agents * number_of_states);
+	terminal_states.resize(number_of_agents * number_of_states);
+	state_rewards.resize(number_of_agents * number_of_states);
+	qvalues.assign(number_of_agents * number_of_states * 4, 0.0f);
+	states.resize(number_of_agents);
+	initial_states.resize(number_of_agents);
+	rng_states.resize(number_of_agents);
+	learning_rates.resize(number_of_agents);
+	episode_steps.assign(number_of_agents, 0);
+	episodes.assign(number_of_agents, 0);
+	successes.assign(number_of_agents, 0);
+	sum_of_steps.assign(number_of_agents, 0);
+	sum_of_rewards.assign(number_of_agents, 0.0f);
+
+	// Seed the generator, from which the states of generators of agents are drawn.
+	uint64_t seed_value = (seed < 0) ? ((uint64_t)std::random_device()() << 32) ^ std::random_device()() : (uint64_t)seed;
+	mic::types::Xoshiro256 rng(seed_value);
+	for (size_t i=0; i<number_of_agents; i++) {
+		// Every agent has its own gridworld.
+		if (i > 0)
+			grid_env.initializeEnvironment();
+		transition_model.build(grid_env, step_reward, 0.0f);
+
+		for (size_t s=0; s<number_of_states; s++) {
+			action_masks[i * number_of_states + s] = transition_model.getActionMask(s);
+			terminal_states[i * number_of_states + s] = transition_model.isStateTerminal(s);
+			state_rewards[i * number_of_states + s] = transition_model.getStateReward(s);
+		}//: for
+		mic::types::Position2D pos = grid_env.getAgentPosition();
+		initial_states[i] = transition_model.stateIndex(pos.x, pos.y);
+		states[i] = initial_states[i];
+
+		// Seed must be non-zero.
+		rng_states[i] = (uint32_t)(rng() >> 32) | 1;
+		learning_rates[i] = (number_of_agents > 1) ?
+				learning_rate_min + (learning_rate_max - learning_rate_min) * i / (number_of_agents - 1) : (float)learning_rate_min;
+	}//: for
+
+	LOG(LSTATUS) << "Generated " << number_of_agents << " gridworlds with " << number_of_states << " states";
+}
+
+
+void GridworldBatchQLearning::stepAgents() {
+	const float ninf = -std::numeric_limits<float>::infinity();
+	const size_t agents = number_of_agents;
+	const size_t S = number_of_states;
+	const float r = step_reward;
+	const float gamma = discount_rate;
+	const double eps = epsilon;
+	const uint32_t limit = (step_limit > 0) ? (uint32_t)step_limit : std::numeric_limits<uint32_t>::max();
+
+	uint8_t* masks = action_masks.data();
+	float* q = qvalues.data();
+
+	// Step of all agents - a scalar loop, as Q-values are gathered and updated at data-dependent positions.
+	for (size_t i=0; i<agents; i++) {
+		uint32_t s = states[i];
+		const uint8_t* masks_i = masks + i * S;
+		float* q_i = q + i * S * 4;
+
+		// Draw random number (xorshift32).
+		uint32_t x = rng_states[i];
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		rng_states[i] = x;
+		float u = (x >> 8) * (1.0f / 16777216.0f);
+		uint32_t random_action = (x >> 4) & 3;
+
+		// Greedy action - masked argmax (tournament).
+		uint8_t mask = masks_i[s];
+		const float* q_s = q_i + s * 4;
+		float m0 = (mask & 1) ? q_s[0] : ninf;
+		float m1 = (mask & 2) ? q_s[1] : ninf;
+		float m2 = (mask & 4) ? q_s[2] : ninf;
+		float m3 = (mask & 8) ? q_s[3] : ninf;
+		float v01 = (m1 > m0) ? m1 : m0;
+		uint32_t i01 = (m1 > m0) ? 1 : 0;
+		float v23 = (m3 > m2) ? m3 : m2;
+		uint32_t i23 = (m3 > m2) ? 3 : 2;
+		uint32_t greedy_action = (v23 > v01) ? i23 : i01;
+		float greedy_value = (v23 > v01) ? v23 : v01;
+
+		// Epsilon-greedy selection (random also if there is no greedy action).
+		float eps_i = (eps < 0) ? 1.0f / (1.0f + episodes[i]) : (float)eps;
+		bool explore = (u < eps_i) | (greedy_value == ninf);
+		uint32_t a = explore ? random_action : greedy_action;
+
+		// Move - agent "bumps" (and receives double step reward) if the action is not allowed.
+		bool allowed = (mask >> a) & 1;
+		uint32_t next = allowed ? (uint32_t)((int32_t)s + state_deltas[a]) : s;
+		float reward = allowed ? r : 2 * r;
+
+		// Max Q in the next state.
+		uint8_t next_mask = masks_i[next];
+		const float* q_n = q_i + next * 4;
+		float n0 = (next_mask & 1) ? q_n[0] : ninf;
+		float n1 = (next_mask & 2) ? q_n[1] : ninf;
+		float n2 = (next_mask & 4) ? q_n[2] : ninf;
+		float n3 = (next_mask & 8) ? q_n[3] : ninf;
+		float n01 = (n1 > n0) ? n1 : n0;
+		float n23 = (n3 > n2) ? n3 : n2;
+		float max_next = (n23 > n01) ? n23 : n01;
+
+		// Q-learning update.
+		float & q_sa = q_i[s * 4 + a];
+		q_sa += learning_rates[i] * (reward + gamma * max_next - q_sa);
+
+		states[i] = next;
+		episode_steps[i]++;
+	}//: for
+
+	// Finish episodes of agents that reached terminal states or the step limit (rare - separate pass).
+	for (size_t i=0; i<agents; i++) {
+		uint32_t s = states[i];
+		bool terminal = terminal_states[i * S + s];
+		if ((!terminal) && (episode_steps[i] < limit))
+			continue;
+		if (terminal) {
+			// In the terminal state all actions receive the same value related to the "reward".
+			float final_reward = state_rewards[i * S + s];
+			for (size_t a=0; a<4; a++)
+				q[(i * S + s) * 4 + a] = final_reward;
+			sum_of_rewards[i] += final_reward;
+			if (final_reward > 0)
+				successes[i]++;
+		}//: if
+		sum_of_steps[i] += episode_steps[i];
+		episodes[i]++;
+		episode_steps[i] = 0;
+		states[i] = initial_states[i];
+	}//: for
+}
+
+
+void GridworldBatchQLearning::exportStatistics() {
+	std::ofstream file(statistics_filename);
+	file << "agent,learning_rate,episodes,success_ratio,average_number_of_steps,average_collected_reward" << std::endl;
+	for (size_t i=0; i<number_of_agents; i++) {
+		float e = (episodes[i] > 0) ? (float)episodes[i] : 1.0f;
+		file << i << "," << learning_rates[i] << "," << episodes[i] << "," << successes[i] / e << ","
+				<< sum_of_steps[i] / e << "," << sum_of_rewards[i] / e << std::endl;
+	}//: for
+	LOG(LINFO) << "Statistics exported to " << (std::string)statistics_filename;
+}
+
+
+bool GridworldBatchQLearning::performSingleStep() {
+	LOG(LTRACE) << "Performing a single step (" << iteration << ")";
+
+	std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+	for (size_t t=0; t<number_of_steps; t++)
+		stepAgents();
+	std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+	// Summarize.
+	uint64_t total_episodes = 0, total_successes = 0;
+	for (size_t i=0; i<number_of_agents; i++) {
+		total_episodes += episodes[i];
+		total_successes += successes[i];
+	}//: for
+	LOG(LSTATUS) << number_of_agents << " agents, " << number_of_steps << " steps: " << total_episodes << " episodes, success ratio = "
+			<< ((total_episodes > 0) ? (float)total_successes / total_episodes : 0.0f);
+	LOG(LSTATUS) << "Time = " << elapsed.count() << "s, updates/sec = " << (number_of_agents * number_of_steps) / elapsed.count();
+
+	exportStatistics();
+
+	// Done.
+	return false;
+}
+
+
+} /* namespace application */
+} /* namespace mic */
@@ -0,0 +1,182 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file GridworldBatchQLearning.hpp
+ * \brief Contains declaration of the application running many independent tabular Q-learning agents in lockstep.
+ * \author tkornut
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_APPLICATION_GRIDWORLDBATCHQLEARNING_HPP_
+#define SRC_APPLICATION_GRIDWORLDBATCHQLEARNING_HPP_
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include <application/Application.hpp>
+
+#include <types/Gridworld.hpp>
+#include <types/TransitionModel.hpp>
+
+namespace mic {
+namespace application {
+
+/*!
+ * \brief Headless application advancing many independent tabular Q-learning agents in lockstep, each on its own gridworld.
+ * The agents are stored in a structure-of-arrays layout (states, Q-tables, action masks, random generator states),
+ * so the single step of all agents is a tight loop over contiguous arrays, without branches on the agent data.
+ * Learning rates of the agents are spread linearly between learning_rate_min and learning_rate_max, which enables
+ * comparison of hyperparameters in a single run. The statistics of every agent are exported to a CSV file.
+ * \author tkornuta
+ */
+class GridworldBatchQLearning: public mic::application::Application {
+public:
+	/*!
+	 * Default Constructor. Sets the application/node name, default values of variables etc.
+	 * @param node_name_ Name of the application/node (in configuration file).
+	 */
+	GridworldBatchQLearning(std::string node_name_ = "application");
+
+	/*!
+	 * Destructor.
+	 */
+	virtual ~GridworldBatchQLearning();
+
+protected:
+	/*!
+	 * Initializes all variables that are property-dependent - generates the gridworlds of all agents.
+	 */
+	virtual void initializePropertyDependentVariables();
+
+	/*!
+	 * Method empty (not used).
+	 * @param argc Number of application parameters.
+	 * @param argv Array of application parameters.
+	 */
+	virtual void initialize(int argc, char* argv[]);
+
+	/*!
+	 * Performs the whole run: number_of_steps lockstep steps of all agents, then exports the statistics.
+	 */
+	virtual bool performSingleStep();
+
+private:
+	/*!
+	 * Performs a single step of all agents.
+	 */
+	void stepAgents();
+
+	/*!
+	 * Exports the statistics of all agents to the CSV file.
+	 */
+	void exportStatistics();
+
+	/// The gridworld object - used for generation of the gridworlds of agents.
+	mic::environments::Gridworld grid_env;
+
+	/// Transition model - used for extraction of the properties of the generated gridworlds.
+	mic::types::TransitionModel transition_model;
+
+	/// Property: number of agents.
+	mic::configuration::Property<size_t> number_of_agents;
+
+	/// Property: number of lockstep steps performed by all agents.
+	mic::configuration::Property<size_t> number_of_steps;
+
+	/*!
+	 * Property: the "expected intermediate reward", i.e. reward received by performing each step (typically negative, but can be positive as all).
+	 */
+	mic::configuration::Property<float> step_reward;
+
+	/*!
+	 * Property: future discount (should be in range 0.0-1.0).
+	 */
+	mic::configuration::Property<float> discount_rate;
+
+	/// Property: learning rate of the first agent.
+	mic::configuration::Property<float> learning_rate_min;
+
+	/// Property: learning rate of the last agent.
+	mic::configuration::Property<float> learning_rate_max;
+
+	/*!
+	 * Property: variable denoting epsilon in action selection (the probability "below" which a random action will be selected).
+	 * if epsilon < 0 then if will be set to 1/episode, hence change dynamically depending on the episode number (of given agent).
+	 */
+	mic::configuration::Property<double> epsilon;
+
+	/// Property: limit of steps for episode. Setting step_limit <= 0 means that the limit should not be considered.
+	mic::configuration::Property<int> step_limit;
+
+	/*!
+	 * Property: seed of the generator. Setting seed < 0 means that the generator will be seeded by std::random_device.
+	 */
+	mic::configuration::Property<long> seed;
+
+	/// Property: name of the file to which the statistics will be exported.
+	mic::configuration::Property<std::string> statistics_filename;
+
+	/// Number of states of a single gridworld.
+	size_t number_of_states;
+
+	/// Changes of the state index caused by actions (NESW).
+	int32_t state_deltas[4];
+
+	/// Masks of allowed actions - [agent][state].
+	std::vector<uint8_t> action_masks;
+
+	/// Flags of terminal states - [agent][state].
+	std::vector<uint8_t> terminal_states;
+
+	/// Rewards of states - [agent][state].
+	std::vector<float> state_rewards;
+
+	/// Q-tables - [agent][state][action].
+	std::vector<float> qvalues;
+
+	/// Current states of agents.
+	std::vector<uint32_t> states;
+
+	/// Initial states of agents.
+	std::vector<uint32_t> initial_states;
+
+	/// States of random generators (xorshift32) of agents.
+	std::vector<uint32_t> rng_states;
+
+	/// Learning rates of agents.
+	std::vector<float> learning_rates;
+
+	/// Number of steps performed in the current episode by agents.
+	std::vector<uint32_t> episode_steps;
+
+	/// Number of finished episodes of agents.
+	std::vector<uint32_t> episodes;
+
+	/// Number of successful episodes (goal reached) of agents.
+	std::vector<uint32_t> successes;
+
+	/// Sum of steps of finished episodes of agents.
+	std::vector<uint64_t> sum_of_steps;
+
+	/// Sum of rewards collected in finished episodes of agents.
+	std::vector<float> sum_of_rewards;
+};
+
+} /* namespace application */
+} /* namespace mic */
+
+#endif /* SRC_APPLICATION_GRIDWORLDBATCHQLEARNING_HPP_ */
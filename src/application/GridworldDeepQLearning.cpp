@@ -23,6 +23,7 @@
 #include <limits>
 #include <utils/RandomGenerator.hpp>
 #include <application/GridworldDeepQLearning.hpp>
+#include <application/Trace.hpp>
 
 namespace mic {
 namespace application {
@@ -42,9 +43,12 @@ GridworldDeepQLearning::GridworldDeepQLearning(std::string node_name_) : OpenGLE
 		learning_rate("learning_rate", 0.1),
 		epsilon("epsilon", 0.1),
 		statistics_filename("statistics_filename","dql_statistics.csv"),
+		statistics_flush_interval("statistics_flush_interval", 1),
+		statistics_binary("statistics_binary", false),
 		mlnn_filename("mlnn_filename", "dql_mlnn.txt"),
 		mlnn_save("mlnn_save", false),
-		mlnn_load("mlnn_load", false)
+		mlnn_load("mlnn_load", false),
+		environment_pool_size("environment_pool_size", 0)
 	{
 	// Register properties - so their values can be overridden (read from the configuration file).
 	registerProperty(step_reward);
@@ -52,9 +56,12 @@ GridworldDeepQLearning::GridworldDeepQLearning(std::string node_name_) : OpenGLE
 	registerProperty(learning_rate);
 	registerProperty(epsilon);
 	registerProperty(statistics_filename);
+	registerProperty(statistics_flush_interval);
+	registerProperty(statistics_binary);
 	registerProperty(mlnn_filename);
 	registerProperty(mlnn_save);
 	registerProperty(mlnn_load);
+	registerProperty(environment_pool_size);
 
 	LOG(LINFO) << "Properties registered";
 }
@@ -89,6 +96,12 @@ void GridworldDeepQLearning::initializePropertyDependentVariables() {
 	// Initialize the gridworld.
 	grid_env.initializeEnvironment();
 
+	// Start the background generation of environments (if required).
+	if (environment_pool_size > 0) {
+		environment_pool = std::make_shared<mic::environments::EnvironmentPool<mic::environments::Gridworld> >(grid_env, environment_pool_size);
+		environment_pool->start();
+	}//: if
+
 	// Try to load neural network from file.
 	if ((mlnn_load) && (neural_net.load(mlnn_filename))) {
 		// Do nothing ;)
@@ -110,14 +123,20 @@ void GridworldDeepQLearning::initializePropertyDependentVariables() {
 
 		LOG(LINFO) << "Generated new neural network";
 	}//: else
+
+	// Create the statistics file.
+	statistics_writer.open(statistics_filename, {"number_of_steps", "average_number_of_steps", "collected_reward", "average_collected_reward"}, statistics_flush_interval, statistics_binary);
 }
 
 
 void GridworldDeepQLearning::startNewEpisode() {
 	LOG(LSTATUS) << "Starting new episode " << episode;
 
-	// Generate the gridworld (and move player to initial position).
-	grid_env.initializeEnvironment();
+	// Take the pre-generated environment or generate it (and move player to initial position).
+	if (environment_pool)
+		environment_pool->acquire(grid_env);
+	else
+		grid_env.initializeEnvironment();
 
 	LOG(LSTATUS) << "Network responses: \n" <<  streamNetworkResponseTable();
 	LOG(LSTATUS) << "Environment: \n" << grid_env.environmentToString();
@@ -132,14 +151,17 @@ void GridworldDeepQLearning::finishCurrentEpisode() {
 	sum_of_iterations += iteration;
 	sum_of_rewards += reward;
 
+	float average_number_of_steps = (float)sum_of_iterations/episode;
+	float average_collected_reward = (float)sum_of_rewards/episode;
+
 	// Add variables to container.
 	collector_ptr->addDataToContainer("number_of_steps",iteration);
-	collector_ptr->addDataToContainer("average_number_of_steps",(float)sum_of_iterations/episode);
+	collector_ptr->addDataToContainer("average_number_of_steps",average_number_of_steps);
 	collector_ptr->addDataToContainer("collected_reward", reward);
-	collector_ptr->addDataToContainer("average_collected_reward", (float)sum_of_rewards/episode);
+	collector_ptr->addDataToContainer("average_collected_reward", average_collected_reward);
 
-	// Export reward "convergence" diagram.
-	collector_ptr->exportDataToCsv(statistics_filename);
+	// Append the row to the reward "convergence" diagram.
+	statistics_writer.addRow({(float)iteration, average_number_of_steps, reward, average_collected_reward});
 
 	// Save nn to file.
 	if (mlnn_save)
@@ -285,7 +307,7 @@ mic::types::NESWAction GridworldDeepQLearning::selectBestActionForCurrentState()
 }
 
 bool GridworldDeepQLearning::performSingleStep() {
-	LOG(LSTATUS) << "Episode "<< episode << ": step " << iteration << "";
+	TRACE(TRACE_STEP, LSTATUS) << "Episode "<< episode << ": step " << iteration << "";
 
 	// TMP!
 	double 	nn_weight_decay = 0;
@@ -300,8 +322,8 @@ bool GridworldDeepQLearning::performSingleStep() {
 	MatrixXfPtr tmp_rewards_t = getPredictedRewardsForCurrentState();
 	// ... but make a local copy!
 	MatrixXfPtr predicted_rewards_t (new MatrixXf(*tmp_rewards_t));
-	LOG(LINFO) << "Agent position at state t: " << player_pos_t;
-	LOG(LSTATUS) << "Predicted rewards for state t: " << predicted_rewards_t->transpose();
+	TRACE(TRACE_STEP, LINFO) << "Agent position at state t: " << player_pos_t;
+	TRACE(TRACE_DUMP, LSTATUS) << "Predicted rewards for state t: " << predicted_rewards_t->transpose();
 
 	// Select the action.
 	mic::types::NESWAction action;
@@ -311,7 +333,7 @@ bool GridworldDeepQLearning::performSingleStep() {
 		eps = 1.0/(1.0+sqrt(episode));
 	if (eps < 0.1)
 		eps = 0.1;
-	LOG(LDEBUG) << "eps = " << eps;
+	TRACE(TRACE_STEP, LDEBUG) << "eps = " << eps;
 	bool random = false;
 
 	// Epsilon-greedy action selection.
@@ -335,7 +357,7 @@ bool GridworldDeepQLearning::performSingleStep() {
 		// Get new state s(t+1).
 		mic::types::Position2D player_pos_t_prim = grid_env.getAgentPosition();
 
-		LOG(LINFO) << "Agent position at t+1: " << player_pos_t_prim << " after performing the action = " << action << ((random) ? " [Random]" : "");
+		TRACE(TRACE_STEP, LINFO) << "Agent position at t+1: " << player_pos_t_prim << " after performing the action = " << action << ((random) ? " [Random]" : "");
 
 		// Check whether state t+1 is terminal.
 		if(grid_env.isStateTerminal(player_pos_t_prim))
@@ -346,8 +368,8 @@ bool GridworldDeepQLearning::performSingleStep() {
 			// Get best value for the NEXT state (!).
 			float max_q_st_prim_at_prim = computeBestValueForCurrentState();
 
-			LOG(LWARNING) << "step_reward = " << step_reward;
-			LOG(LWARNING) << "max_q_st_prim_at_prim = " << max_q_st_prim_at_prim;
+			TRACE(TRACE_STEP, LWARNING) << "step_reward = " << step_reward;
+			TRACE(TRACE_STEP, LWARNING) << "max_q_st_prim_at_prim = " << max_q_st_prim_at_prim;
 
 			// If next state best value is finite.
 			if (std::isfinite(max_q_st_prim_at_prim))
@@ -364,16 +386,16 @@ bool GridworldDeepQLearning::performSingleStep() {
 
 
 	// Deep Q learning - train network with the desired values.
-	LOG(LERROR) << "Training with state: " << encoded_state_t->transpose();
-	LOG(LERROR) << "Training with desired rewards: " << predicted_rewards_t->transpose();
-	LOG(LSTATUS) << "Network responses before training:" << std::endl << streamNetworkResponseTable();
+	TRACE(TRACE_DUMP, LERROR) << "Training with state: " << encoded_state_t->transpose();
+	TRACE(TRACE_DUMP, LERROR) << "Training with desired rewards: " << predicted_rewards_t->transpose();
+	TRACE(TRACE_DUMP, LSTATUS) << "Network responses before training:" << std::endl << streamNetworkResponseTable();
 
 	// Train network with rewards.
 	float loss = neural_net.train (encoded_state_t, predicted_rewards_t, learning_rate, nn_weight_decay);
-	LOG(LSTATUS) << "Training loss:" << loss;
+	TRACE(TRACE_STEP, LSTATUS) << "Training loss:" << loss;
 
-	LOG(LSTATUS) << "Network responses after training:" << std::endl << streamNetworkResponseTable();
-	LOG(LSTATUS) << "Current environment: \n"  << grid_env.environmentToString();
+	TRACE(TRACE_DUMP, LSTATUS) << "Network responses after training:" << std::endl << streamNetworkResponseTable();
+	TRACE(TRACE_DUMP, LSTATUS) << "Current environment: \n"  << grid_env.environmentToString();
 
 	// Remember the previous position.
 	player_pos_t_minus_prim = player_pos_t;
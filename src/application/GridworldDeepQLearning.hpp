@@ -36,6 +36,8 @@ using namespace mic::mlnn;
 using namespace mic::types;
 
 #include <types/Gridworld.hpp>
+#include <types/EnvironmentPool.hpp>
+#include <application/StatisticsWriter.hpp>
 
 namespace mic {
 namespace application {
@@ -96,9 +98,15 @@ private:
 	/// Data collector.
 	mic::utils::DataCollectorPtr<std::string, float> collector_ptr;
 
+	/// Append-only writer of the statistics.
+	StatisticsWriter statistics_writer;
+
 	/// The gridworld environment.
 	mic::environments::Gridworld grid_env;
 
+	/// Pool of environments generated in a background thread (empty if not used).
+	std::shared_ptr<mic::environments::EnvironmentPool<mic::environments::Gridworld> > environment_pool;
+
 	/*!
 	 * Property: the "expected intermediate reward", i.e. reward received by performing each step (typically negative, but can be positive as all).
 	 */
@@ -123,6 +131,12 @@ private:
 	/// Property: name of the file to which the statistics will be exported.
 	mic::configuration::Property<std::string> statistics_filename;
 
+	/// Property: number of rows of statistics buffered before they are appended to the file.
+	mic::configuration::Property<size_t> statistics_flush_interval;
+
+	/// Property: flag denoting whether the statistics should be exported in the binary format (instead of CSV).
+	mic::configuration::Property<bool> statistics_binary;
+
 	/// Property: name of the file to which the neural network will be serialized (or deserialized from).
 	mic::configuration::Property<std::string> mlnn_filename;
 
@@ -132,6 +146,12 @@ private:
 	/// Property: flad denoting thether the nn should be loaded from a file (at the initialization of the task).
 	mic::configuration::Property<bool> mlnn_load;
 
+	/*!
+	 * Property: number of environments (episodes) pre-generated in a background thread.
+	 * Setting environment_pool_size = 0 means that the environment is generated at the beginning of every episode in the main thread.
+	 */
+	mic::configuration::Property<size_t> environment_pool_size;
+
 	/// Multi-layer neural network used for approximation of the Qstate rewards.
 	BackpropagationNeuralNetwork<float> neural_net;
 
@@ -0,0 +1,238 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file GridworldPolicyIteration.cpp
+ * \brief Definitions of the methods of class responsible for solving the gridworld problem with policy iteration.
+ * \author tkornut
+ * \date Oct 18, 2026
+ */
+
+#include <limits>
+#include <application/GridworldPolicyIteration.hpp>
+#include <application/Trace.hpp>
+
+namespace mic {
+namespace application {
+
+/*!
+ * \brief Registers the application.
+ * \author tkornuta
+ */
+void RegisterApplication (void) {
+	REGISTER_APPLICATION(mic::application::GridworldPolicyIteration);
+}
+
+
+GridworldPolicyIteration::GridworldPolicyIteration(std::string node_name_) : Application(node_name_),
+		step_reward("step_reward", 0.0),
+		discount_rate("discount_rate", 0.9),
+		move_noise("move_noise",0.2),
+		solver_tolerance("solver_tolerance", 1e-06)
+	{
+	// Register properties - so their values can be overridden (read from the configuration file).
+	registerProperty(step_reward);
+	registerProperty(discount_rate);
+	registerProperty(move_noise);
+	registerProperty(solver_tolerance);
+
+	LOG(LINFO) << "Properties registered";
+}
+
+
+GridworldPolicyIteration::~GridworldPolicyIteration() {
+
+}
+
+
+void GridworldPolicyIteration::initialize(int argc, char* argv[]) {
+
+}
+
+
+void GridworldPolicyIteration::initializePropertyDependentVariables() {
+	// Initialize the gridworld.
+	grid_env.initializeEnvironment();
+
+	// Build the transition model.
+	transition_model.build(grid_env, step_reward, move_noise);
+
+	// Initial policy: the first allowed action.
+	size_t number_of_states = transition_model.getNumberOfStates();
+	policy.assign(number_of_states, -1);
+	for (size_t s=0; s<number_of_states; s++) {
+		if ((!transition_model.isStateAllowed(s)) || transition_model.isStateTerminal(s))
+			continue;
+		for (size_t a=0; a<4; a++) {
+			if (transition_model.isActionAllowed(s, a)) {
+				policy[s] = a;
+				break;
+			}//: if
+		}//: for
+	}//: for
+
+	state_values.setZero(number_of_states);
+}
+
+
+float GridworldPolicyIteration::computeQValueFromValues(size_t state_, size_t action_) {
+	const uint32_t* next_states = transition_model.getNextStates();
+	const float* probabilities = transition_model.getProbabilities();
+	const float* rewards = transition_model.getRewards();
+
+	float q_value = 0;
+	float probs_normalizer = 0;
+	for (uint32_t t=transition_model.transitionsBegin(state_, action_); t<transition_model.transitionsEnd(state_, action_); t++) {
+		q_value += probabilities[t]*(rewards[t] + discount_rate * state_values(next_states[t]));
+		probs_normalizer += probabilities[t];
+	}//: for
+
+	// Normalize the probabilities.
+	return q_value / probs_normalizer;
+}
+
+
+bool GridworldPolicyIteration::evaluatePolicy() {
+	const uint32_t* next_states = transition_model.getNextStates();
+	const float* probabilities = transition_model.getProbabilities();
+	const float* rewards = transition_model.getRewards();
+	size_t number_of_states = transition_model.getNumberOfStates();
+
+	// Build the system (I - gamma * P_pi) V = R_pi.
+	std::vector<Eigen::Triplet<float> > triplets;
+	triplets.reserve(number_of_states * 4);
+	Eigen::VectorXf rhs(number_of_states);
+	for (size_t s=0; s<number_of_states; s++) {
+		triplets.push_back(Eigen::Triplet<float>(s, s, 1.0f));
+		if (transition_model.isStateTerminal(s)) {
+			// Value of the terminal state is equal to its reward.
+			rhs(s) = transition_model.getStateReward(s);
+			continue;
+		}//: if
+		if (policy[s] < 0) {
+			// Walls and states without allowed actions.
+			rhs(s) = 0.0f;
+			continue;
+		}//: if
+
+		uint32_t begin = transition_model.transitionsBegin(s, policy[s]);
+		uint32_t end = transition_model.transitionsEnd(s, policy[s]);
+		float probs_normalizer = 0;
+		for (uint32_t t=begin; t<end; t++)
+			probs_normalizer += probabilities[t];
+
+		rhs(s) = 0.0f;
+		for (uint32_t t=begin; t<end; t++) {
+			float p = probabilities[t] / probs_normalizer;
+			triplets.push_back(Eigen::Triplet<float>(s, next_states[t], -discount_rate * p));
+			rhs(s) += p * rewards[t];
+		}//: for
+	}//: for
+
+	Eigen::SparseMatrix<float> system(number_of_states, number_of_states);
+	system.setFromTriplets(triplets.begin(), triplets.end());
+
+	// Solve it - warm start from the values of the previous policy.
+	Eigen::BiCGSTAB<Eigen::SparseMatrix<float>, Eigen::IncompleteLUT<float> > solver;
+	solver.setTolerance(solver_tolerance);
+	solver.compute(system);
+	if (solver.info() != Eigen::Success) {
+		LOG(LERROR) << "Decomposition of the policy evaluation system failed";
+		return false;
+	}//: if
+	state_values = solver.solveWithGuess(rhs, state_values);
+
+	LOG(LINFO) << "Policy evaluation: " << solver.iterations() << " solver iterations, estimated error = " << solver.error();
+	return (solver.info() == Eigen::Success);
+}
+
+
+size_t GridworldPolicyIteration::improvePolicy() {
+	size_t number_of_states = transition_model.getNumberOfStates();
+	size_t changes = 0;
+	for (size_t s=0; s<number_of_states; s++) {
+		if (policy[s] < 0)
+			continue;
+		int best_action = policy[s];
+		float best_qvalue = computeQValueFromValues(s, policy[s]);
+		for (size_t a=0; a<4; a++) {
+			if (!transition_model.isActionAllowed(s, a))
+				continue;
+			float qvalue = computeQValueFromValues(s, a);
+			// Change the action only if it is noticeably better - avoids oscillations between equivalent actions.
+			if (qvalue > best_qvalue + 1e-05) {
+				best_qvalue = qvalue;
+				best_action = a;
+			}//: if
+		}//: for
+		if (best_action != policy[s]) {
+			policy[s] = best_action;
+			changes++;
+		}//: if
+	}//: for
+	return changes;
+}
+
+
+std::string GridworldPolicyIteration::streamValuesAndPolicy() {
+	std::ostringstream os;
+	os << "State values and policy:" << std::endl;
+	for (size_t y=0; y<transition_model.getHeight(); y++){
+		os << "| ";
+		for (size_t x=0; x<transition_model.getWidth(); x++) {
+			size_t s = transition_model.stateIndex(x,y);
+			if (!transition_model.isStateAllowed(s)) {
+				os << "# | ";
+				continue;
+			}//: if
+			os << state_values(s);
+			switch(policy[s]){
+				case 0 : os << " N | "; break;
+				case 1 : os << " E | "; break;
+				case 2 : os << " S | "; break;
+				case 3 : os << " W | "; break;
+				default: os << " - | ";
+			}//: switch
+		}//: for x
+		os << std::endl;
+	}//: for y
+	return os.str();
+}
+
+
+bool GridworldPolicyIteration::performSingleStep() {
+	LOG(LTRACE) << "Performing a single step (" << iteration << ")";
+
+	// Policy evaluation.
+	if (!evaluatePolicy())
+		LOG(LWARNING) << "Policy evaluation did not converge";
+
+	// Policy improvement.
+	size_t changes = improvePolicy();
+
+	TRACE(TRACE_DUMP, LSTATUS) << std::endl << grid_env.environmentToString();
+	TRACE(TRACE_DUMP, LSTATUS) << std::endl << streamValuesAndPolicy();
+	TRACE(TRACE_STEP, LINFO) << "Policy changed in " << changes << " states";
+
+	// Stop when the policy is stable.
+	if (changes == 0)
+		return false;
+
+	return true;
+}
+
+
+} /* namespace application */
+} /* namespace mic */
@@ -0,0 +1,138 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file GridworldPolicyIteration.hpp
+ * \brief Contains declaration of the application solving the gridworld problem with policy iteration.
+ * \author tkornut
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_APPLICATION_GRIDWORLDPOLICYITERATION_HPP_
+#define SRC_APPLICATION_GRIDWORLDPOLICYITERATION_HPP_
+
+#include <vector>
+#include <string>
+
+#include <application/Application.hpp>
+
+#include <types/Gridworld.hpp>
+#include <types/TransitionModel.hpp>
+
+#include <Eigen/Sparse>
+
+namespace mic {
+namespace application {
+
+/*!
+ * \brief Class responsible for solving the gridworld problem with policy iteration.
+ * Every step consists of the policy evaluation - performed as a sparse linear solve (I - gamma * P_pi) V = R_pi
+ * with BiCGSTAB - followed by the greedy policy improvement. Uses the same transition model (with move noise) as value iteration.
+ * \author tkornuta
+ */
+class GridworldPolicyIteration: public mic::application::Application {
+public:
+	/*!
+	 * Default Constructor. Sets the application/node name, default values of variables etc.
+	 * @param node_name_ Name of the application/node (in configuration file).
+	 */
+	GridworldPolicyIteration(std::string node_name_ = "application");
+
+	/*!
+	 * Destructor.
+	 */
+	virtual ~GridworldPolicyIteration();
+
+protected:
+	/*!
+	 * Initializes all variables that are property-dependent.
+	 */
+	virtual void initializePropertyDependentVariables();
+
+	/*!
+	 * Method empty (not used).
+	 * @param argc Number of application parameters.
+	 * @param argv Array of application parameters.
+	 */
+	virtual void initialize(int argc, char* argv[]);
+
+	/*!
+	 * Performs single step of computations - policy evaluation and improvement.
+	 */
+	virtual bool performSingleStep();
+
+private:
+
+	/// The gridworld object.
+	mic::environments::Gridworld grid_env;
+
+	/// Transition model of the gridworld.
+	mic::types::TransitionModel transition_model;
+
+	/// Values of all states, indexed as states of the transition model (y * width + x).
+	Eigen::VectorXf state_values;
+
+	/// Current policy - action selected in every state (-1 if there is no action to be selected).
+	std::vector<int> policy;
+
+	/*!
+	 * Property: the "expected intermediate reward", i.e. reward received by performing each step (typically negative, but can be positive as all).
+	 */
+	mic::configuration::Property<float> step_reward;
+
+	/*!
+	 * Property: future discount factor (should be in range 0.0-1.0).
+	 */
+	mic::configuration::Property<float> discount_rate;
+
+	/*!
+	 * Property: move noise, determining gow often action results in unintended direction.
+	 */
+	mic::configuration::Property<float> move_noise;
+
+	/// Property: tolerance of the iterative linear solver.
+	mic::configuration::Property<float> solver_tolerance;
+
+	/*!
+	 * Evaluates the current policy - solves the sparse linear system.
+	 * @return True if the solver converged.
+	 */
+	bool evaluatePolicy();
+
+	/*!
+	 * Improves the policy greedily with respect to the current values.
+	 * @return Number of states in which the action has changed.
+	 */
+	size_t improvePolicy();
+
+	/*!
+	 * Calculates the Q-value, taking into consideration probabilistic transition between states.
+	 * @param state_ Starting state (index in the transition model).
+	 * @param action_ Action to be performed.
+	 * @return Q-value.
+	 */
+	float computeQValueFromValues(size_t state_, size_t action_);
+
+	/*!
+	 * Steams the current state values and policy.
+	 * @return String with description of the values and policy.
+	 */
+	std::string streamValuesAndPolicy();
+};
+
+} /* namespace application */
+} /* namespace mic */
+
+#endif /* SRC_APPLICATION_GRIDWORLDPOLICYITERATION_HPP_ */
@@ -21,6 +21,7 @@
  */
 
 #include <application/GridworldQLearning.hpp>
+#include <application/Trace.hpp>
 
 #include <limits>
 #include <utils/RandomGenerator.hpp>
@@ -44,7 +45,9 @@ GridworldQLearning::GridworldQLearning(std::string node_name_) : OpenGLEpisodicA
 		learning_rate("learning_rate", 0.1),
 		move_noise("move_noise",0.2),
 		epsilon("epsilon", 0.1),
-		statistics_filename("statistics_filename","statistics_filename.csv")
+		statistics_filename("statistics_filename","statistics_filename.csv"),
+		statistics_flush_interval("statistics_flush_interval", 1),
+		statistics_binary("statistics_binary", false)
 
 	{
 	// Register properties - so their values can be overridden (read from the configuration file).
@@ -54,6 +57,8 @@ GridworldQLearning::GridworldQLearning(std::string node_name_) : OpenGLEpisodicA
 	registerProperty(move_noise);
 	registerProperty(epsilon);
 	registerProperty(statistics_filename);
+	registerProperty(statistics_flush_interval);
+	registerProperty(statistics_binary);
 
 	LOG(LINFO) << "Properties registered";
 }
@@ -87,13 +92,16 @@ void GridworldQLearning::initialize(int argc, char* argv[]) {
 void GridworldQLearning::initializePropertyDependentVariables() {
 	// Initialize the gridworld.
 	grid_env.initializeEnvironment();
+	transition_model.build(grid_env, step_reward, move_noise);
 
 	// Resize and reset the action-value table.
-	qstate_table.resize({grid_env.getEnvironmentWidth(),grid_env.getEnvironmentHeight(),4});
-	qstate_table.zeros();
+	qstate_table.resize(transition_model.getNumberOfStates());
 	//qstate_table.setValue( -std::numeric_limits<float>::infinity() );
 
 	LOG(LSTATUS) << std::endl << streamQStateTable();
+
+	// Create the statistics file.
+	statistics_writer.open(statistics_filename, {"number_of_steps", "average_number_of_steps", "collected_reward", "average_collected_reward"}, statistics_flush_interval, statistics_binary);
 }
 
 
@@ -102,6 +110,7 @@ void GridworldQLearning::startNewEpisode() {
 
 	// Generate the gridworld (and move player to initial position).
 	grid_env.initializeEnvironment();
+	transition_model.build(grid_env, step_reward, move_noise);
 
 	LOG(LSTATUS) << std::endl << streamQStateTable();
 	LOG(LSTATUS) << std::endl << grid_env.environmentToString();
@@ -116,14 +125,17 @@ void GridworldQLearning::finishCurrentEpisode() {
 	sum_of_iterations += iteration;
 	sum_of_rewards += reward;
 
+	float average_number_of_steps = (float)sum_of_iterations/episode;
+	float average_collected_reward = (float)sum_of_rewards/episode;
+
 	// Add variables to container.
 	collector_ptr->addDataToContainer("number_of_steps",iteration);
-	collector_ptr->addDataToContainer("average_number_of_steps",(float)sum_of_iterations/episode);
+	collector_ptr->addDataToContainer("average_number_of_steps",average_number_of_steps);
 	collector_ptr->addDataToContainer("collected_reward", reward);
-	collector_ptr->addDataToContainer("average_collected_reward", (float)sum_of_rewards/episode);
+	collector_ptr->addDataToContainer("average_collected_reward", average_collected_reward);
 
-	// Export reward "convergence" diagram.
-	collector_ptr->exportDataToCsv(statistics_filename);
+	// Append the row to the reward "convergence" diagram.
+	statistics_writer.addRow({(float)iteration, average_number_of_steps, reward, average_collected_reward});
 
 }
 
@@ -143,8 +155,9 @@ std::string GridworldQLearning::streamQStateTable() {
 			float bestqval = -std::numeric_limits<float>::infinity();
 			size_t best_action = -1;
 			for (size_t a=0; a<4; a++) {
-				float qval = qstate_table({x,y,a});
-				if ( qstate_table({x,y,a}) == -std::numeric_limits<float>::infinity())
+				size_t state = transition_model.stateIndex(x,y);
+				float qval = qstate_table(state,a);
+				if ( qval == -std::numeric_limits<float>::infinity())
 					rewards_table += "-INF";
 				else
 					rewards_table += std::to_string(qval);
@@ -154,7 +167,7 @@ std::string GridworldQLearning::streamQStateTable() {
 					rewards_table += " , ";
 
 				// Remember the best value.
-				if (grid_env.isStateAllowed(x,y) && (!grid_env.isStateTerminal(x,y)) && grid_env.isActionAllowed(x,y,a) && (qval > bestqval)){
+				if (transition_model.isStateAllowed(state) && (!transition_model.isStateTerminal(state)) && transition_model.isActionAllowed(state,a) && (qval > bestqval)){
 					bestqval = qval;
 					best_action = a;
 				}//: if
@@ -179,62 +192,30 @@ std::string GridworldQLearning::streamQStateTable() {
 
 
 float GridworldQLearning::computeBestValue(mic::types::Position2D pos_){
-	float qbest_value = -std::numeric_limits<float>::infinity();
 	// Check if the state is allowed.
-	if (!grid_env.isStateAllowed(pos_))
-		return qbest_value;
-
-	// Create a list of possible actions.
-	std::vector<mic::types::NESWAction> actions;
-	actions.push_back(A_NORTH);
-	actions.push_back(A_EAST);
-	actions.push_back(A_SOUTH);
-	actions.push_back(A_WEST);
-
-	// Check the actions one by one.
-	for(mic::types::NESWAction action : actions) {
-		if(grid_env.isActionAllowed(pos_, action)) {
-			float qvalue = qstate_table({(size_t)pos_.x, (size_t)pos_.y, (size_t)action.getType()});
-			if (qvalue > qbest_value)
-				qbest_value = qvalue;
-		}//if is allowed
-	}//: for
-
-	return qbest_value;
+	size_t state = transition_model.stateIndex(pos_.x, pos_.y);
+	if (!transition_model.isStateAllowed(state))
+		return -std::numeric_limits<float>::infinity();
+
+	// Masked max over the allowed actions.
+	return qstate_table.getBestValue(state, transition_model.getActionMask(state));
 }
 
 mic::types::NESWAction GridworldQLearning::selectBestAction(mic::types::Position2D pos_){
 	LOG(LTRACE) << "Select best action for state" << pos_;
 
 	// Greedy methods - returns the index of element with greatest value.
-	mic::types::NESWAction best_action = A_NONE;
-    float best_qvalue = -std::numeric_limits<float>::infinity();
-
-	// Create a list of possible actions.
-	std::vector<mic::types::NESWAction> actions;
-	actions.push_back(A_NORTH);
-	actions.push_back(A_EAST);
-	actions.push_back(A_SOUTH);
-	actions.push_back(A_WEST);
-
-	// Check the actions one by one.
-	for(mic::types::NESWAction action : actions) {
-		if(grid_env.isActionAllowed(pos_, action)) {
-			float qvalue = qstate_table({(size_t)pos_.x, (size_t)pos_.y, (size_t)action.getType()});
-			std::cout << "  qvalue = " << qvalue << std::endl;
-			if (qvalue > best_qvalue){
-				best_qvalue = qvalue;
-				best_action = action;
-				std::cout << "  best_qvalue = " << best_qvalue << std::endl;
-			}
-		}//if is allowed
-	}//: for
-
-	return best_action;
+	size_t state = transition_model.stateIndex(pos_.x, pos_.y);
+	float best_qvalue;
+	int best_action = qstate_table.getBestAction(state, transition_model.getActionMask(state), best_qvalue);
+
+	if ((best_action < 0) || (best_qvalue == -std::numeric_limits<float>::infinity()))
+		return A_NONE;
+	return mic::types::NESWAction((mic::types::NESW)best_action);
 }
 
 bool GridworldQLearning::performSingleStep() {
-	LOG(LSTATUS) << "Episode "<< episode << ": step " << iteration << "";
+	TRACE(TRACE_STEP, LSTATUS) << "Episode "<< episode << ": step " << iteration << "";
 
 	// Get state s(t).
 	mic::types::Position2D agent_pos_t = grid_env.getAgentPosition();
@@ -245,12 +226,12 @@ bool GridworldQLearning::performSingleStep() {
 		// All "other" actions receive the same value related to the "reward".
 		float final_reward = grid_env.getStateReward(agent_pos_t);
 		for (size_t a=0; a<4; a++)
-			qstate_table({(size_t)agent_pos_t.x,(size_t)agent_pos_t.y, a}) = final_reward;
+			qstate_table(transition_model.stateIndex(agent_pos_t.x, agent_pos_t.y), a) = final_reward;
 
-		LOG(LINFO) << "Agent action = " << A_EXIT;
-		LOG(LDEBUG) << "Agent position = " << agent_pos_t;
-		LOG(LSTATUS) << std::endl << grid_env.environmentToString();
-		LOG(LSTATUS) << std::endl << streamQStateTable();
+		TRACE(TRACE_STEP, LINFO) << "Agent action = " << A_EXIT;
+		TRACE(TRACE_STEP, LDEBUG) << "Agent position = " << agent_pos_t;
+		TRACE(TRACE_DUMP, LSTATUS) << std::endl << grid_env.environmentToString();
+		TRACE(TRACE_DUMP, LSTATUS) << std::endl << streamQStateTable();
 
 		// Finish the episode.
 		return false;
@@ -261,7 +242,7 @@ bool GridworldQLearning::performSingleStep() {
 	double eps = (double)epsilon;
 	if ((double)epsilon < 0)
 		eps = 1.0/(1.0+episode);
-	LOG(LDEBUG) << "eps =" << eps;
+	TRACE(TRACE_STEP, LDEBUG) << "eps =" << eps;
 	bool random = false;
 
 	// Epsilon-greedy action selection.
@@ -279,7 +260,7 @@ bool GridworldQLearning::performSingleStep() {
 		random = true;
 	}//: if
 
-	LOG(LINFO) << action  << action << ((random) ? " [Random]" : "");
+	TRACE(TRACE_STEP, LINFO) << action  << action << ((random) ? " [Random]" : "");
 
 	// Execture action - until success.
 	grid_env.moveAgent(action);
@@ -292,25 +273,26 @@ bool GridworldQLearning::performSingleStep() {
 	// Get new state s(t+1).
 	mic::types::Position2D agent_pos_t_prim = grid_env.getAgentPosition();
 
-	LOG(LINFO) << "Agent position at t+1: " << agent_pos_t_prim << " after performing the action = " << action << ((random) ? " [Random]" : "");
+	TRACE(TRACE_STEP, LINFO) << "Agent position at t+1: " << agent_pos_t_prim << " after performing the action = " << action << ((random) ? " [Random]" : "");
 
 
 	// Update running average for given action - Q learning;)
-	float q_st_at = qstate_table({(size_t)agent_pos_t.x, (size_t)agent_pos_t.y, (size_t)action.getType()});
+	size_t state_t = transition_model.stateIndex(agent_pos_t.x, agent_pos_t.y);
+	float q_st_at = qstate_table(state_t, (size_t)action.getType());
 	float r = step_reward;
 	float max_q_st_prim_at_prim = computeBestValue(agent_pos_t_prim);
-	LOG(LDEBUG) << "q_st_at = " << q_st_at;
-	LOG(LDEBUG) << "agent_t_prim = " << agent_pos_t_prim;
-	LOG(LDEBUG) << "step_reward = " << step_reward;
-	LOG(LDEBUG) << "max_q_st_prim_at_prim = " << max_q_st_prim_at_prim;
+	TRACE(TRACE_STEP, LDEBUG) << "q_st_at = " << q_st_at;
+	TRACE(TRACE_STEP, LDEBUG) << "agent_t_prim = " << agent_pos_t_prim;
+	TRACE(TRACE_STEP, LDEBUG) << "step_reward = " << step_reward;
+	TRACE(TRACE_STEP, LDEBUG) << "max_q_st_prim_at_prim = " << max_q_st_prim_at_prim;
 	//if (std::isfinite(q_st_at) && std::isfinite(max_q_st_prim_at_prim))
 	if (agent_pos_t == agent_pos_t_prim)
-		qstate_table({(size_t)agent_pos_t.x, (size_t)agent_pos_t.y, (size_t)action.getType()}) = q_st_at + learning_rate * (2*r + discount_rate*max_q_st_prim_at_prim - q_st_at);
+		qstate_table(state_t, (size_t)action.getType()) = q_st_at + learning_rate * (2*r + discount_rate*max_q_st_prim_at_prim - q_st_at);
 	else
-		qstate_table({(size_t)agent_pos_t.x, (size_t)agent_pos_t.y, (size_t)action.getType()}) = q_st_at + learning_rate * (r + discount_rate*max_q_st_prim_at_prim - q_st_at);
+		qstate_table(state_t, (size_t)action.getType()) = q_st_at + learning_rate * (r + discount_rate*max_q_st_prim_at_prim - q_st_at);
 
-	LOG(LSTATUS) << std::endl << streamQStateTable();
-	LOG(LSTATUS) << std::endl << grid_env.environmentToString();
+	TRACE(TRACE_DUMP, LSTATUS) << std::endl << streamQStateTable();
+	TRACE(TRACE_DUMP, LSTATUS) << std::endl << grid_env.environmentToString();
 
 	return true;
 }
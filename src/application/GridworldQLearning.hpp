@@ -31,6 +31,9 @@
 using namespace mic::opengl::visualization;
 
 #include <types/Gridworld.hpp>
+#include <types/TransitionModel.hpp>
+#include <types/QTable.hpp>
+#include <application/StatisticsWriter.hpp>
 
 namespace mic {
 namespace application {
@@ -92,11 +95,17 @@ private:
 	/// Data collector.
 	mic::utils::DataCollectorPtr<std::string, float> collector_ptr;
 
+	/// Append-only writer of the statistics.
+	StatisticsWriter statistics_writer;
+
 	/// The gridworld object.
 	mic::environments::Gridworld grid_env;
 
-	/// Tensor storing values for all states (gridworld w * h * 4 (number of actions)). COL MAJOR(!).
-	mic::types::TensorXf qstate_table;
+	/// Transition model of the gridworld - rebuilt when the gridworld is (re)generated.
+	mic::types::TransitionModel transition_model;
+
+	/// Flat table storing values of all state-action pairs ([state][action], states indexed as in the transition model).
+	mic::types::QTable qstate_table;
 
 	/*!
 	 * Property: the "expected intermediate reward", i.e. reward received by performing each step (typically negative, but can be positive as all).
@@ -127,6 +136,12 @@ private:
 	/// Property: name of the file to which the statistics will be exported.
 	mic::configuration::Property<std::string> statistics_filename;
 
+	/// Property: number of rows of statistics buffered before they are appended to the file.
+	mic::configuration::Property<size_t> statistics_flush_interval;
+
+	/// Property: flag denoting whether the statistics should be exported in the binary format (instead of CSV).
+	mic::configuration::Property<bool> statistics_binary;
+
 	/*!
 	 * Steams the current state of the state-action values.
 	 * @return Ostream with description of the state-action table.
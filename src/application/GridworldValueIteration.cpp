@@ -22,8 +22,12 @@
 
 
 #include <limits>
+#include <algorithm>
+#include <thread>
+#include <chrono>
 #include <utils/RandomGenerator.hpp>
 #include <application/GridworldValueIteration.hpp>
+#include <application/Trace.hpp>
 
 namespace mic {
 namespace application {
@@ -41,6 +45,9 @@ GridworldValueIteration::GridworldValueIteration(std::string node_name_) : Appli
 		step_reward("step_reward", 0.0),
 		discount_rate("discount_rate", 0.9),
 		move_noise("move_noise",0.2),
+		solver_type("solver_type", 0),
+		number_of_threads("number_of_threads", 0),
+		max_sweeps("max_sweeps", 10000),
 		statistics_filename("statistics_filename","statistics_filename.csv")
 
 	{
@@ -48,6 +55,9 @@ GridworldValueIteration::GridworldValueIteration(std::string node_name_) : Appli
 	registerProperty(step_reward);
 	registerProperty(discount_rate);
 	registerProperty(move_noise);
+	registerProperty(solver_type);
+	registerProperty(number_of_threads);
+	registerProperty(max_sweeps);
 	registerProperty(statistics_filename);
 
 	LOG(LINFO) << "Properties registered";
@@ -67,11 +77,27 @@ void GridworldValueIteration::initializePropertyDependentVariables() {
 	// Initialize the gridworld.
 	grid_env.initializeEnvironment();
 
-	// Resize and reset the action-value table.
-	state_value_table.resize(grid_env.getEnvironmentHeight(), grid_env.getEnvironmentWidth());
-	//state_value_table.zeros();
-	state_value_table.setValue( -std::numeric_limits<float>::infinity() );
+	// Build the transition model.
+	transition_model.build(grid_env, step_reward, move_noise);
+
+	// Resize and reset the state-value table.
+	state_values.assign(transition_model.getNumberOfStates(), -std::numeric_limits<float>::infinity());
+	new_state_values.assign(transition_model.getNumberOfStates(), -std::numeric_limits<float>::infinity());
 	running_delta = -std::numeric_limits<float>::infinity();
+	number_of_state_updates = 0;
+
+	// Prioritized sweeping: queue all states with their initial residuals.
+	if (solver_type == 2) {
+		priorities.assign(transition_model.getNumberOfStates(), 0.0f);
+		priority_queue = std::priority_queue<std::pair<float, uint32_t> >();
+		for (size_t s=0; s<transition_model.getNumberOfStates(); s++) {
+			float residual = computeResidual(computeStateValue(s), state_values[s]);
+			if (residual > 1e-05) {
+				priorities[s] = residual;
+				priority_queue.push(std::make_pair(residual, (uint32_t)s));
+			}//: if
+		}//: for
+	}//: if
 
 	LOG(LSTATUS) << std::endl << streamStateActionTable();
 }
@@ -83,10 +109,11 @@ std::string GridworldValueIteration::streamStateActionTable() {
 	for (size_t y=0; y<grid_env.getEnvironmentHeight(); y++){
 		os << "| ";
 		for (size_t x=0; x<grid_env.getEnvironmentWidth(); x++) {
-			if ( state_value_table(y,x) == -std::numeric_limits<float>::infinity())
+			float value = state_values[transition_model.stateIndex(x,y)];
+			if ( value == -std::numeric_limits<float>::infinity())
 				os << "-INF | ";
 			else
-				os << state_value_table(y,x) << " | ";
+				os << value << " | ";
 		}//: for x
 		os << std::endl;
 	}//: for y
@@ -96,47 +123,24 @@ std::string GridworldValueIteration::streamStateActionTable() {
 
 
 
-float GridworldValueIteration::computeQValueFromValues(mic::types::Position2D pos_, mic::types::NESWAction ac_){
-	//  Compute the Q-value of action in state from the value function stored table.
-	mic::types::Position2D new_pos = pos_ + ac_;
-	float q_value = (1-move_noise)*(step_reward + discount_rate * state_value_table((size_t)new_pos.y, (size_t)new_pos.x));
-	float probs_normalizer = (1-move_noise);
-
-	// Consider also east and west actions as possible actions - due to move_noise.
-	if ((ac_.getType() == types::NESW::North) || (ac_.getType() == types::NESW::South)) {
-		if (grid_env.isActionAllowed(pos_, A_EAST)) {
-			mic::types::Position2D east_pos = pos_ + A_EAST;
-			if (state_value_table((size_t)east_pos.y, (size_t)east_pos.x) != -std::numeric_limits<float>::infinity()) {
-				q_value += (move_noise/2)*(step_reward + discount_rate * state_value_table( (size_t)east_pos.y, (size_t)east_pos.x));
-				probs_normalizer += (move_noise/2);
-			}//:if != -INF
-		}//: if
-		if (grid_env.isActionAllowed(pos_, A_WEST)) {
-			mic::types::Position2D west_pos = pos_ + A_WEST;
-			if (state_value_table((size_t)west_pos.y, (size_t)west_pos.x) != -std::numeric_limits<float>::infinity()) {
-				q_value += (move_noise/2)*(step_reward + discount_rate * state_value_table((size_t)west_pos.y, (size_t)west_pos.x));
-				probs_normalizer += (move_noise/2);
-			}//:if != -INF
-		}//: if
-	}//: if
+float GridworldValueIteration::computeQValueFromValues(size_t state_, size_t action_){
+	const uint32_t* next_states = transition_model.getNextStates();
+	const float* probabilities = transition_model.getProbabilities();
+	const float* rewards = transition_model.getRewards();
+	uint32_t begin = transition_model.transitionsBegin(state_, action_);
+	uint32_t end = transition_model.transitionsEnd(state_, action_);
 
-	// Consider also north and south actions as possible actions - due to move_noise.
-	if ((ac_.getType() == types::NESW::East) || (ac_.getType() == types::NESW::West)) {
-		if (grid_env.isActionAllowed(pos_, A_NORTH)) {
-			mic::types::Position2D north_pos = pos_ + A_NORTH;
-			if (state_value_table((size_t)north_pos.y, (size_t)north_pos.x) != -std::numeric_limits<float>::infinity()) {
-				q_value += (move_noise/2)*(step_reward + discount_rate * state_value_table((size_t)north_pos.y, (size_t)north_pos.x));
-				probs_normalizer += (move_noise/2);
-			}//:if != -INF
-		}//: if
-		if (grid_env.isActionAllowed(pos_, A_SOUTH)) {
-			mic::types::Position2D south_pos = pos_ + A_SOUTH;
-			if (state_value_table((size_t)south_pos.y, (size_t)south_pos.x) != -std::numeric_limits<float>::infinity()) {
-				q_value += (move_noise/2)*(step_reward + discount_rate * state_value_table((size_t)south_pos.y, (size_t)south_pos.x));
-				probs_normalizer += (move_noise/2);
-			}//:if != -INF
-		}//: if
-	}//: if
+	//  Compute the Q-value of action in state from the value function stored table.
+	float q_value = 0;
+	float probs_normalizer = 0;
+	for (uint32_t t=begin; t<end; t++) {
+		float next_value = state_values[next_states[t]];
+		// Consider slips (due to move_noise) only to states that already have their values computed.
+		if ((t != begin) && (next_value == -std::numeric_limits<float>::infinity()))
+			continue;
+		q_value += probabilities[t]*(rewards[t] + discount_rate * next_value);
+		probs_normalizer += probabilities[t];
+	}//: for
 
 	// Normalize the probabilities.
 	q_value /= probs_normalizer;
@@ -144,23 +148,16 @@ float GridworldValueIteration::computeQValueFromValues(mic::types::Position2D po
 	return q_value;
 }
 
-float GridworldValueIteration::computeBestValue(mic::types::Position2D pos_){
+float GridworldValueIteration::computeBestValue(size_t state_){
 	float best_value = -std::numeric_limits<float>::infinity();
 	// Check if the state is allowed.
-	if (!grid_env.isStateAllowed(pos_))
+	if (!transition_model.isStateAllowed(state_))
 		return best_value;
 
-	// Create a list of possible actions.
-	std::vector<mic::types::NESWAction> actions;
-	actions.push_back(A_NORTH);
-	actions.push_back(A_EAST);
-	actions.push_back(A_SOUTH);
-	actions.push_back(A_WEST);
-
 	// Check the actions one by one.
-	for(mic::types::NESWAction action : actions) {
-		if(grid_env.isActionAllowed(pos_, action)) {
-			float value = computeQValueFromValues(pos_, action);
+	for(size_t a=0; a<4; a++) {
+		if(transition_model.isActionAllowed(state_, a)) {
+			float value = computeQValueFromValues(state_, a);
 			if (value > best_value)
 				best_value = value;
 		}//if is allowed
@@ -170,48 +167,195 @@ float GridworldValueIteration::computeBestValue(mic::types::Position2D pos_){
 }
 
 
-bool GridworldValueIteration::performSingleStep() {
-	LOG(LTRACE) << "Performing a single step (" << iteration << ")";
+float GridworldValueIteration::computeStateValue(size_t state_){
+	// Terminal states - the state reward.
+	if (transition_model.isStateTerminal(state_))
+		return transition_model.getStateReward(state_);
+	// Else - compute the best value.
+	return computeBestValue(state_);
+}
 
-	// Perform the iterative policy iteration.
-	mic::types::MatrixXf new_state_value_table(grid_env.getEnvironmentHeight(), grid_env.getEnvironmentWidth());
-	new_state_value_table.setValue( -std::numeric_limits<float>::infinity() );
 
-	for (size_t y=0; y<grid_env.getEnvironmentHeight(); y++){
-		for (size_t x=0; x<grid_env.getEnvironmentWidth(); x++) {
-			mic::types::Position2D pos(x,y);
-			if (grid_env.isStateTerminal(pos) ) {
-				// Set the state rewared.
-				new_state_value_table((size_t)pos.y, (size_t)pos.x) = grid_env.getStateReward(pos);
-				continue;
-			}//: if
-			// Else - compute the best value.
-			if (grid_env.isStateAllowed(pos) )
-				new_state_value_table((size_t)pos.y, (size_t)pos.x) = computeBestValue(pos);
-		}//: for x
-	}//: for y
+float GridworldValueIteration::computeResidual(float new_value_, float old_value_){
+	bool new_finite = std::isfinite(new_value_);
+	bool old_finite = std::isfinite(old_value_);
+	if (new_finite && old_finite)
+		return std::abs(new_value_ - old_value_);
+	if (new_finite != old_finite)
+		return std::numeric_limits<float>::infinity();
+	return 0.0f;
+}
+
+
+void GridworldValueIteration::performJacobiSweep() {
+	size_t number_of_states = transition_model.getNumberOfStates();
+	for (size_t s=0; s<number_of_states; s++)
+		new_state_values[s] = computeStateValue(s);
+	number_of_state_updates += number_of_states;
 
 	// Compute delta.
-	mic::types::MatrixXf delta_value;
 	float curr_delta = 0;
-	for (size_t i =0; i < (size_t) grid_env.getEnvironmentWidth() * grid_env.getEnvironmentHeight(); i++){
+	for (size_t i =0; i < number_of_states; i++){
 		float tmp_delta = 0;
-		if (std::isfinite(new_state_value_table(i)))
-			tmp_delta += new_state_value_table(i);
-		if (std::isfinite(state_value_table(i)))
-			tmp_delta -= state_value_table(i);
+		if (std::isfinite(new_state_values[i]))
+			tmp_delta += new_state_values[i];
+		if (std::isfinite(state_values[i]))
+			tmp_delta -= state_values[i];
 		curr_delta += std::abs(tmp_delta);
 	}//: for
 	running_delta = curr_delta;
 
 	// Update state.
-	state_value_table = new_state_value_table;
+	state_values.swap(new_state_values);
+}
 
-	LOG(LSTATUS) << std::endl << grid_env.environmentToString();
-	LOG(LSTATUS) << std::endl << streamStateActionTable();
-	LOG(LINFO) << "Delta Value = " << running_delta;
 
-	if (running_delta < 1e-05)
+void GridworldValueIteration::performGaussSeidelSweep() {
+	size_t number_of_states = transition_model.getNumberOfStates();
+	float curr_delta = 0;
+	for (size_t s=0; s<number_of_states; s++) {
+		float value = computeStateValue(s);
+		float tmp_delta = 0;
+		if (std::isfinite(value))
+			tmp_delta += value;
+		if (std::isfinite(state_values[s]))
+			tmp_delta -= state_values[s];
+		curr_delta += std::abs(tmp_delta);
+		// Update the value in place - it will be used by the following states.
+		state_values[s] = value;
+	}//: for
+	number_of_state_updates += number_of_states;
+	running_delta = curr_delta;
+}
+
+
+bool GridworldValueIteration::performPrioritizedSweep() {
+	const uint32_t* predecessors = transition_model.getPredecessors();
+	size_t number_of_states = transition_model.getNumberOfStates();
+	float curr_delta = 0;
+
+	for (size_t i=0; (i<number_of_states) && (!priority_queue.empty()); ) {
+		std::pair<float, uint32_t> top = priority_queue.top();
+		priority_queue.pop();
+		uint32_t s = top.second;
+		// Skip outdated entries.
+		if (top.first != priorities[s])
+			continue;
+		priorities[s] = 0.0f;
+
+		// Update the state.
+		float value = computeStateValue(s);
+		float residual = computeResidual(value, state_values[s]);
+		if (std::isfinite(residual))
+			curr_delta += residual;
+		state_values[s] = value;
+		number_of_state_updates++;
+		i++;
+
+		// Update the priorities of predecessors.
+		for (uint32_t p=transition_model.predecessorsBegin(s); p<transition_model.predecessorsEnd(s); p++) {
+			uint32_t pred = predecessors[p];
+			float pred_residual = computeResidual(computeStateValue(pred), state_values[pred]);
+			if ((pred_residual > 1e-05) && (pred_residual > priorities[pred])) {
+				priorities[pred] = pred_residual;
+				priority_queue.push(std::make_pair(pred_residual, pred));
+			}//: if
+		}//: for
+	}//: for
+	running_delta = curr_delta;
+
+	return !priority_queue.empty();
+}
+
+
+float GridworldValueIteration::updateBand(size_t colour_, size_t first_row_, size_t last_row_) {
+	size_t width = transition_model.getWidth();
+	float max_residual = 0;
+	for (size_t y=first_row_; y<last_row_; y++) {
+		for (size_t x=(y + colour_) % 2; x<width; x+=2) {
+			size_t s = transition_model.stateIndex(x,y);
+			float value = computeStateValue(s);
+			float residual = computeResidual(value, state_values[s]);
+			if (residual > max_residual)
+				max_residual = residual;
+			state_values[s] = value;
+		}//: for x
+	}//: for y
+	return max_residual;
+}
+
+
+void GridworldValueIteration::performParallelSweep(size_t threads_) {
+	size_t height = transition_model.getHeight();
+	std::vector<float> partial_deltas(threads_, 0.0f);
+
+	for (size_t colour=0; colour<2; colour++) {
+		// Each worker processes its own band of rows.
+		std::vector<std::thread> workers;
+		for (size_t t=0; t<threads_; t++) {
+			size_t first_row = height * t / threads_;
+			size_t last_row = height * (t+1) / threads_;
+			workers.push_back(std::thread([this, &partial_deltas, colour, t, first_row, last_row]() {
+				partial_deltas[t] = std::max(partial_deltas[t], updateBand(colour, first_row, last_row));
+			}));
+		}//: for
+		for (std::thread & worker : workers)
+			worker.join();
+	}//: for colour
+
+	// Reduce the deltas - the sweep is as far from convergence as its worst state.
+	running_delta = 0;
+	for (float delta : partial_deltas)
+		running_delta = std::max(running_delta, delta);
+	number_of_state_updates += transition_model.getNumberOfStates();
+}
+
+
+void GridworldValueIteration::solveInParallel() {
+	size_t threads = (number_of_threads > 0) ? (size_t)number_of_threads : std::thread::hardware_concurrency();
+	if (threads == 0)
+		threads = 1;
+	// Do not use more workers than rows.
+	if (threads > transition_model.getHeight())
+		threads = transition_model.getHeight();
+
+	std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+	size_t sweeps = 0;
+	do {
+		performParallelSweep(threads);
+		sweeps++;
+		LOG(LINFO) << "Sweep " << sweeps << ": Max Residual = " << running_delta;
+	} while ((running_delta >= 1e-05) && ((max_sweeps <= 0) || (sweeps < (size_t)max_sweeps)));
+	std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+	if (running_delta >= 1e-05)
+		LOG(LWARNING) << "Parallel solver stopped after " << sweeps << " sweeps without convergence (max residual = " << running_delta << ")";
+
+	LOG(LSTATUS) << "Solved " << transition_model.getNumberOfStates() << " states using " << threads << " threads: "
+			<< sweeps << " sweeps, time = " << elapsed.count() << "s";
+}
+
+
+bool GridworldValueIteration::performSingleStep() {
+	LOG(LTRACE) << "Performing a single step (" << iteration << ")";
+
+	// Perform the iterative policy iteration.
+	bool unfinished = true;
+	switch(solver_type) {
+		case 1 : performGaussSeidelSweep(); break;
+		case 2 : unfinished = performPrioritizedSweep(); break;
+		case 3 : solveInParallel(); unfinished = false; break;
+		case 0 :
+		default: performJacobiSweep();
+	}//: switch
+
+	TRACE(TRACE_DUMP, LSTATUS) << std::endl << grid_env.environmentToString();
+	TRACE(TRACE_DUMP, LSTATUS) << std::endl << streamStateActionTable();
+	TRACE(TRACE_STEP, LINFO) << "Delta Value = " << running_delta;
+	TRACE(TRACE_STEP, LINFO) << "Number of state updates = " << number_of_state_updates;
+
+	// Prioritized sweeping finishes when there are no states to be updated, sweeps when the delta is small enough.
+	if ((!unfinished) || ((solver_type != 2) && (running_delta < 1e-05)))
 		return false;
 
 	return true;
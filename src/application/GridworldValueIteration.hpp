@@ -25,10 +25,12 @@
 
 #include <vector>
 #include <string>
+#include <queue>
 
 #include <application/Application.hpp>
 
 #include <types/Gridworld.hpp>
+#include <types/TransitionModel.hpp>
 #include <types/MatrixTypes.hpp>
 #include <types/Action2D.hpp>
 #include <types/Position2D.hpp>
@@ -78,8 +80,14 @@ private:
 	/// The gridworld object.
 	mic::environments::Gridworld grid_env;
 
-	/// Matrix storing values for all states (gridworld w * h). ROW MAJOR(!).
-	mic::types::MatrixXf state_value_table;
+	/// Transition model of the gridworld - built once, used in all sweeps.
+	mic::types::TransitionModel transition_model;
+
+	/// Values of all states (gridworld w * h), indexed as states of the transition model (y * width + x).
+	std::vector<float> state_values;
+
+	/// Values of all states computed in the current sweep.
+	std::vector<float> new_state_values;
 
 	/*!
 	 * Property: the "expected intermediate reward", i.e. reward received by performing each step (typically negative, but can be positive as all).
@@ -96,14 +104,39 @@ private:
 	 */
 	mic::configuration::Property<float> move_noise;
 
+	/*!
+	 * Property: type of the solver.
+	 * Currently available types:
+	 * 0: synchronous (Jacobi) sweeps - all states are updated on the basis of the values from the previous sweep.
+	 * 1: in-place (Gauss-Seidel) sweeps - updated values are used immediately.
+	 * 2: prioritized sweeping - states are updated in the order of their Bellman residuals (max-heap).
+	 * 3: parallel red-black sweeps - the grid is divided into bands of rows processed by worker threads, the whole problem is solved in a single step (headless mode for large grids).
+	 */
+	mic::configuration::Property<short> solver_type;
+
+	/// Property: number of worker threads used by the parallel solver (0 means the number of hardware threads).
+	mic::configuration::Property<size_t> number_of_threads;
+
+	/// Property: limit of sweeps performed by the parallel solver. Setting max_sweeps <= 0 means that the limit should not be considered.
+	mic::configuration::Property<int> max_sweeps;
+
 	/// Property: name of the file to which the statistics will be exported.
 	mic::configuration::Property<std::string> statistics_filename;
 
 	/*!
-	 * Running delta being the sum of increments of the value table.
+	 * Running delta being the sum of increments of the value table (the maximal Bellman residual in the case of the parallel solver).
 	 */
 	float running_delta;
 
+	/// Total number of performed state updates (backups).
+	size_t number_of_state_updates;
+
+	/// Priorities (Bellman residuals) of states queued for prioritized sweeping.
+	std::vector<float> priorities;
+
+	/// Max-heap of (residual, state) pairs used in prioritized sweeping - may contain outdated entries.
+	std::priority_queue<std::pair<float, uint32_t> > priority_queue;
+
 	/*!
 	 * Steams the current state of the state-action values.
 	 * @return Ostream with description of the state-action table.
@@ -113,18 +146,72 @@ private:
 
 	/*!
 	 * Calculates the Q-value, taking into consideration probabilistic transition between states (i.e. that north action can end up going east or west)
-	 * @param pos_ Starting state (position).
-	 * @param ac_ Action to be performed.
+	 * @param state_ Starting state (index in the transition model).
+	 * @param action_ Action to be performed.
 	 * @return Value ofr the function
 	 */
-	float computeQValueFromValues(mic::types::Position2D pos_, mic::types::NESWAction ac_);
+	float computeQValueFromValues(size_t state_, size_t action_);
 
 	/*!
 	 * Calculates the best value for given state - by finding the action having the maximal expected value.
-	 * @param pos_ Starting state (position).
+	 * @param state_ Starting state (index in the transition model).
 	 * @return Value for given state.
 	 */
-	float computeBestValue(mic::types::Position2D pos_);
+	float computeBestValue(size_t state_);
+
+	/*!
+	 * Calculates the new value of the state (i.e. performs the Bellman backup) on the basis of the current values.
+	 * @param state_ State (index in the transition model).
+	 * @return New value of the state.
+	 */
+	float computeStateValue(size_t state_);
+
+	/*!
+	 * Calculates the Bellman residual, i.e. the difference between new and old value of the state.
+	 * Values that are not finite yet (-INF) are treated in a special way: residual is infinite if only one of the values is finite.
+	 * @param new_value_ New value.
+	 * @param old_value_ Old value.
+	 * @return Residual.
+	 */
+	float computeResidual(float new_value_, float old_value_);
+
+	/*!
+	 * Performs a synchronous (Jacobi) sweep over all states.
+	 */
+	void performJacobiSweep();
+
+	/*!
+	 * Performs an in-place (Gauss-Seidel) sweep over all states.
+	 */
+	void performGaussSeidelSweep();
+
+	/*!
+	 * Performs the number of state updates equal to the number of states, in the order of the Bellman residuals.
+	 * @return False if there are no more states to be updated.
+	 */
+	bool performPrioritizedSweep();
+
+	/*!
+	 * Performs a parallel sweep: first all "red" states ((x+y) even) are updated in place, then all "black" ones.
+	 * As the transitions lead only to the neighbouring states (of the other colour), states of one colour can be updated concurrently.
+	 * The maximal residuals computed by workers are reduced (max) into the running delta.
+	 * @param threads_ Number of worker threads.
+	 */
+	void performParallelSweep(size_t threads_);
+
+	/*!
+	 * Updates all states of the given colour lying in the given band of rows.
+	 * @param colour_ Colour of states (0 - red, 1 - black).
+	 * @param first_row_ First row of the band.
+	 * @param last_row_ Row following the last row of the band.
+	 * @return Maximal Bellman residual of the updated states.
+	 */
+	float updateBand(size_t colour_, size_t first_row_, size_t last_row_);
+
+	/*!
+	 * Solves the problem with parallel red-black sweeps - iterates until the maximal residual drops below the tolerance or max_sweeps is reached.
+	 */
+	void solveInParallel();
 
 
 };
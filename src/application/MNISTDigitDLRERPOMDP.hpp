@@ -32,12 +32,16 @@
 using namespace mic::opengl::visualization;
 
 #include <mlnn/BackpropagationNeuralNetwork.hpp>
+#include <algorithms/NetworkCloning.hpp>
+#include <algorithms/AsyncDQNLearner.hpp>
 // Using multi layer neural networks
 using namespace mic::mlnn;
 using namespace mic::types;
 
 #include <types/MNISTDigit.hpp>
 #include <types/SpatialExperienceMemory.hpp>
+#include <types/ObservationExperienceMemory.hpp>
+#include <application/StatisticsWriter.hpp>
 
 namespace mic {
 namespace application {
@@ -99,6 +103,9 @@ private:
 	/// Data collector.
 	mic::utils::DataCollectorPtr<std::string, float> collector_ptr;
 
+	/// Append-only writer of the statistics.
+	StatisticsWriter statistics_writer;
+
 	/// Window displaying the whole environment.
 	WindowMNISTDigit* wmd_environment;
 	/// Window displaying the observation.
@@ -143,6 +150,12 @@ private:
 	/// Property: name of the file to which the statistics will be exported.
 	mic::configuration::Property<std::string> statistics_filename;
 
+	/// Property: number of rows of statistics buffered before they are appended to the file.
+	mic::configuration::Property<size_t> statistics_flush_interval;
+
+	/// Property: flag denoting whether the statistics should be exported in the binary format (instead of CSV).
+	mic::configuration::Property<bool> statistics_binary;
+
 	/// Property: name of the file to which the neural network will be serialized (or deserialized from).
 	mic::configuration::Property<std::string> mlnn_filename;
 
@@ -152,9 +165,47 @@ private:
 	/// Property: flad denoting thether the nn should be loaded from a file (at the initialization of the task).
 	mic::configuration::Property<bool> mlnn_load;
 
+	/*!
+	 * Property: number of training steps between consecutive synchronizations of the target network.
+	 * Setting target_update_interval = 0 means that the target network is not used (targets are computed by the trained network).
+	 */
+	mic::configuration::Property<size_t> target_update_interval;
+
+	/*!
+	 * Property: flag denoting whether the Double DQN target should be used, i.e. the action is selected by the trained network and evaluated by the target network.
+	 */
+	mic::configuration::Property<bool> double_dqn;
+
+	/*!
+	 * Property: horizon of multi-step returns, i.e. number of steps (n) the rewards are accumulated over before bootstrapping (1 means classic one-step Q-learning).
+	 */
+	mic::configuration::Property<size_t> multistep_horizon;
+
+	/*!
+	 * Property: flag denoting whether the network should be trained asynchronously, i.e. by the learner running in a separate thread,
+	 * while the application acts as an actor (interacting with the environment and collecting experiences).
+	 */
+	mic::configuration::Property<bool> async_learner;
+
+	/*!
+	 * Property: number of training steps of the asynchronous learner between consecutive publications of the network to the actor.
+	 */
+	mic::configuration::Property<size_t> publish_interval;
+
 	/// Multi-layer neural network used for approximation of the Qstate rewards.
 	BackpropagationNeuralNetwork<float> neural_net;
 
+	/// Target network - periodically synchronized copy of the neural_net, used for computation of the targets (empty if not used).
+	std::shared_ptr<BackpropagationNeuralNetwork<float> > target_net;
+
+	/// Number of training steps performed till now - used in synchronization of the target network.
+	long long number_of_training_steps;
+
+	/*!
+	 * Synchronizes the target network with the trained one (if target network is used).
+	 */
+	void synchronizeTargetNetwork();
+
 	/*!
 	 * Calculates the best value for the current state and predictions.
 	 * @param player_position_ State (player position).
@@ -163,6 +214,15 @@ private:
 	 */
 	float computeBestValueForGivenStateAndPredictions(mic::types::Position2D player_position_, float* predictions_);
 
+	/*!
+	 * Calculates the Double DQN value for the current state: the best allowed action is selected basing on predictions of the trained network, whereas its value is taken from predictions of the target network.
+	 * @param player_position_ State (player position).
+	 * @param predictions_ Vector of predictions of the trained network.
+	 * @param target_predictions_ Vector of predictions of the target network.
+	 * @return Value of the best possible action for given state.
+	 */
+	float computeDoubleQValueForGivenStateAndPredictions(mic::types::Position2D player_position_, float* predictions_, float* target_predictions_);
+
 	/*!
 	 * Returns the predicted rewards for given state.
 	 * @param player_position_ State (player position).
@@ -177,6 +237,16 @@ private:
 	 */
 	mic::types::NESWAction selectBestActionForGivenState(mic::types::Position2D player_position_);
 
+	/*!
+	 * Returns the network used for action selection: the copy published by the asynchronous learner (if used) or the trained network.
+	 */
+	BackpropagationNeuralNetwork<float> & getActingNetwork();
+
+	/*!
+	 * Fetches the network recently published by the asynchronous learner.
+	 */
+	void updateActorNetwork();
+
 	/*!
 	 * Steams the current network response - values of actions associates with consecutive agent poses.
 	 * @return Ostream with description of the state-action table.
@@ -192,6 +262,21 @@ private:
 	 * Table of past experiences.
 	 */
 	SpatialExperienceMemory experiences;
+
+	/// Memory of experiences in the form of encoded observations - filled by the actor and sampled by the asynchronous learner.
+	mic::types::ObservationExperienceMemory observation_experiences;
+
+	/// Chain accumulating the multi-step experiences of the actor.
+	std::shared_ptr<mic::types::ObservationExperienceChain> observation_chain;
+
+	/// Copy of the network used by the actor (published by the learner).
+	std::shared_ptr<BackpropagationNeuralNetwork<float> > actor_net;
+
+	/// Version of the actor network.
+	size_t actor_net_version;
+
+	/// Asynchronous learner training the neural_net in a separate thread (empty if not used). Must be destroyed before the network and memory.
+	std::shared_ptr<mic::algorithms::AsyncDQNLearner> learner;
 };
 
 } /* namespace application */
@@ -24,6 +24,7 @@
 #include <utils/RandomGenerator.hpp>
 
 #include <application/MazeOfDigitsDLRERPOMPD.hpp>
+#include <application/Trace.hpp>
 
 namespace mic {
 namespace application {
@@ -45,10 +46,19 @@ MazeOfDigitsDLRERPOMPD::MazeOfDigitsDLRERPOMPD(std::string node_name_) : OpenGLE
 		epsilon("epsilon", 0.1),
 		step_limit("step_limit",0),
 		statistics_filename("statistics_filename","maze_of_digits_drl_er_statistics.csv"),
+		statistics_flush_interval("statistics_flush_interval", 1),
+		statistics_binary("statistics_binary", false),
 		mlnn_filename("mlnn_filename", "maze_of_digits_drl_er_mlnn.txt"),
 		mlnn_save("mlnn_save", false),
 		mlnn_load("mlnn_load", false),
-		experiences(10000,1)
+		target_update_interval("target_update_interval", 0),
+		double_dqn("double_dqn", false),
+		multistep_horizon("multistep_horizon", 1),
+		async_learner("async_learner", false),
+		publish_interval("publish_interval", 10),
+		environment_pool_size("environment_pool_size", 0),
+		experiences(10000,1),
+		observation_experiences(10000)
 	{
 	// Register properties - so their values can be overridden (read from the configuration file).
 	registerProperty(step_reward);
@@ -57,9 +67,17 @@ MazeOfDigitsDLRERPOMPD::MazeOfDigitsDLRERPOMPD(std::string node_name_) : OpenGLE
 	registerProperty(epsilon);
 	registerProperty(step_limit);
 	registerProperty(statistics_filename);
+	registerProperty(statistics_flush_interval);
+	registerProperty(statistics_binary);
 	registerProperty(mlnn_filename);
 	registerProperty(mlnn_save);
 	registerProperty(mlnn_load);
+	registerProperty(target_update_interval);
+	registerProperty(double_dqn);
+	registerProperty(multistep_horizon);
+	registerProperty(async_learner);
+	registerProperty(publish_interval);
+	registerProperty(environment_pool_size);
 
 	LOG(LINFO) << "Properties registered";
 }
@@ -85,6 +103,8 @@ void MazeOfDigitsDLRERPOMPD::initialize(int argc, char* argv[]) {
 	collector_ptr->createContainer("path_opt_to_episodic_average",  mic::types::color_rgba(255, 255, 255, 180));
 
 	sum_of_iterations = 0;
+	number_of_training_steps = 0;
+	actor_net_version = 0;
 	sum_of_opt_to_episodic_lenghts = 0;
 
 	// Create the visualization windows - must be created in the same, main thread :]
@@ -97,6 +117,12 @@ void MazeOfDigitsDLRERPOMPD::initializePropertyDependentVariables() {
 	// Initialize the maze.
 	env.initializeEnvironment();
 
+	// Start the background generation of environments (if required).
+	if (environment_pool_size > 0) {
+		environment_pool = std::make_shared<mic::environments::EnvironmentPool<mic::environments::MazeOfDigits> >(env, environment_pool_size);
+		environment_pool->start();
+	}//: if
+
 	// Create windows for the visualization of the whole environment and a single observation.
 	wmd_environment = new WindowMazeOfDigits("Environment", env.getEnvironmentHeight()*20,env.getEnvironmentWidth()*20, 0, 316);
 	wmd_observation = new WindowMazeOfDigits("Observation", env.getObservationHeight()*20,env.getObservationWidth()*20, env.getEnvironmentWidth()*20, 316);
@@ -129,20 +155,41 @@ void MazeOfDigitsDLRERPOMPD::initializePropertyDependentVariables() {
 
 	// Set batch size in experience replay memory.
 	experiences.setBatchSize(batch_size);
+	// Set the horizon of multi-step returns.
+	experiences.setMultiStepParameters(multistep_horizon, discount_rate);
+
+	// Create the target network (if required).
+	synchronizeTargetNetwork();
+	if ((double_dqn) && (target_update_interval == 0))
+		LOG(LWARNING) << "Double DQN requires the target network (target_update_interval > 0), using the standard DQN target instead";
+
+	// Start the asynchronous learner - from now on the neural_net is accessed only by the learner thread.
+	if (async_learner) {
+		observation_chain = std::make_shared<mic::types::ObservationExperienceChain>(observation_experiences, multistep_horizon, discount_rate);
+		learner = std::make_shared<mic::algorithms::AsyncDQNLearner>(neural_net, observation_experiences, batch_size, learning_rate, target_update_interval, double_dqn, publish_interval);
+		updateActorNetwork();
+		learner->start();
+		LOG(LINFO) << "Started the asynchronous learner";
+	}//: if
 
 	// Set displayed matrix pointers.
 	wmd_environment->setMazePointer(env.getEnvironment());
 	wmd_environment->setPathPointer(saccadic_path);
 	wmd_observation->setMazePointer(env.getObservation());
 
+	// Create the statistics file.
+	statistics_writer.open(statistics_filename, {"path_length_episode", "path_length_average", "path_length_optimal", "path_opt_to_episodic", "path_opt_to_episodic_average"}, statistics_flush_interval, statistics_binary);
 }
 
 
 void MazeOfDigitsDLRERPOMPD::startNewEpisode() {
 	LOG(LSTATUS) << "Starting new episode " << episode;
 
-	// Generate the gridworld (and move player to initial position).
-	env.initializeEnvironment();
+	// Take the pre-generated environment or generate it (and move player to initial position).
+	if (environment_pool)
+		environment_pool->acquire(env);
+	else
+		env.initializeEnvironment();
 	saccadic_path->clear();
 	// Add first, initial position to  to saccadic path.
 	saccadic_path->push_back(env.getAgentPosition());
@@ -158,24 +205,33 @@ void MazeOfDigitsDLRERPOMPD::startNewEpisode() {
 void MazeOfDigitsDLRERPOMPD::finishCurrentEpisode() {
 	LOG(LTRACE) << "End current episode";
 
+	// Move the remaining (shorter than horizon) experiences to the memory.
+	experiences.flushPendingTransitions();
+	if (observation_chain)
+		observation_chain->flush();
+
 	sum_of_iterations += iteration -1; // -1 is the fix related to moving the terminal condition to the front of step!
 	float opt_to_episodic = (float)env.optimalPathLength() / (iteration -1);
 	sum_of_opt_to_episodic_lenghts += opt_to_episodic;
 
+	float path_length_average = (float)sum_of_iterations/episode;
+	float path_length_optimal = (float)env.optimalPathLength();
+	float path_opt_to_episodic_average = sum_of_opt_to_episodic_lenghts/episode;
+
 	// Add variables to container.
 	collector_ptr->addDataToContainer("path_length_episode",(iteration -1));
-	collector_ptr->addDataToContainer("path_length_average",(float)sum_of_iterations/episode);
-	collector_ptr->addDataToContainer("path_length_optimal", (float)env.optimalPathLength());
+	collector_ptr->addDataToContainer("path_length_average",path_length_average);
+	collector_ptr->addDataToContainer("path_length_optimal", path_length_optimal);
 	collector_ptr->addDataToContainer("path_opt_to_episodic", opt_to_episodic);
-	collector_ptr->addDataToContainer("path_opt_to_episodic_average", sum_of_opt_to_episodic_lenghts/episode);
+	collector_ptr->addDataToContainer("path_opt_to_episodic_average", path_opt_to_episodic_average);
 
 
-	// Export reward "convergence" diagram.
-	collector_ptr->exportDataToCsv(statistics_filename);
+	// Append the row to the reward "convergence" diagram.
+	statistics_writer.addRow({(float)(iteration -1), path_length_average, path_length_optimal, opt_to_episodic, path_opt_to_episodic_average});
 
 	// Save nn to file.
 	if (mlnn_save && (episode %10))
-		neural_net.save(mlnn_filename);
+		getActingNetwork().save(mlnn_filename);
 }
 
 
@@ -213,9 +269,9 @@ std::string MazeOfDigitsDLRERPOMPD::streamNetworkResponseTable() {
 	}//: for y
 
 	// Get rewards for the whole batch.
-	neural_net.forward(inputs_batch);
+	getActingNetwork().forward(inputs_batch);
 	// Get predictions for all those states - there is no need to create a copy.
-	MatrixXfPtr predicted_batch = neural_net.getPredictions();
+	MatrixXfPtr predicted_batch = getActingNetwork().getPredictions();
 
 
 	rewards_table += "Action values:\n";
@@ -288,6 +344,50 @@ float MazeOfDigitsDLRERPOMPD::computeBestValueForGivenStateAndPredictions(mic::t
 }
 
 
+float MazeOfDigitsDLRERPOMPD::computeDoubleQValueForGivenStateAndPredictions(mic::types::Position2D player_position_, float* predictions_, float* target_predictions_){
+	LOG(LTRACE) << "computeDoubleQValueForGivenStateAndPredictions()";
+	float best_qvalue = -std::numeric_limits<float>::infinity();
+	float best_target_qvalue = -std::numeric_limits<float>::infinity();
+
+	for(size_t a=0; a<4; a++) {
+		// Select the best allowed action basing on the predictions of the trained network...
+		if(env.isActionAllowed(player_position_, mic::types::NESWAction((mic::types::NESW)a))) {
+			if (predictions_[a] > best_qvalue) {
+				best_qvalue = predictions_[a];
+				// ... and evaluate it with the target network.
+				best_target_qvalue = target_predictions_[a];
+			}//: if
+		}//if is allowed
+	}//: for
+
+	return best_target_qvalue;
+}
+
+
+void MazeOfDigitsDLRERPOMPD::synchronizeTargetNetwork() {
+	// Check whether the target network is used at all.
+	if (target_update_interval == 0)
+		return;
+
+	LOG(LINFO) << "Synchronizing the target network after " << number_of_training_steps << " training steps";
+	target_net = mic::algorithms::cloneNetwork(neural_net);
+}
+
+
+BackpropagationNeuralNetwork<float> & MazeOfDigitsDLRERPOMPD::getActingNetwork() {
+	return (actor_net) ? (*actor_net) : neural_net;
+}
+
+
+void MazeOfDigitsDLRERPOMPD::updateActorNetwork() {
+	std::shared_ptr<BackpropagationNeuralNetwork<float> > net = learner->getPublishedNetwork(actor_net_version);
+	if (net) {
+		LOG(LDEBUG) << "Actor network updated to version " << actor_net_version << " (after " << learner->getNumberOfTrainingSteps() << " training steps)";
+		actor_net = net;
+	}//: if
+}
+
+
 mic::types::MatrixXfPtr MazeOfDigitsDLRERPOMPD::getPredictedRewardsForGivenState(mic::types::Position2D player_position_) {
 	LOG(LTRACE) << "getPredictedRewardsForGivenState()";
 	// Remember the current state i.e. player position.
@@ -309,9 +409,9 @@ mic::types::MatrixXfPtr MazeOfDigitsDLRERPOMPD::getPredictedRewardsForGivenState
 	//LOG(LERROR) << "Getting predictions for input batch:\n" <<inputs_batch->transpose();
 
 	// Pass the data and get predictions.
-	neural_net.forward(inputs_batch);
+	getActingNetwork().forward(inputs_batch);
 
-	MatrixXfPtr predictions_batch = neural_net.getPredictions();
+	MatrixXfPtr predictions_batch = getActingNetwork().getPredictions();
 
 	//LOG(LERROR) << "Resulting predictions batch:\n" << predictions_batch->transpose();
 
@@ -362,7 +462,7 @@ mic::types::NESWAction MazeOfDigitsDLRERPOMPD::selectBestActionForGivenState(mic
 }
 
 bool MazeOfDigitsDLRERPOMPD::performSingleStep() {
-	LOG(LSTATUS) << "Episode "<< episode << ": step " << iteration << "";
+	TRACE(TRACE_STEP, LSTATUS) << "Episode "<< episode << ": step " << iteration << "";
 
 	// Check whether state t is terminal - finish the episode.
 	if(env.isStateTerminal(env.getAgentPosition()))
@@ -373,7 +473,11 @@ bool MazeOfDigitsDLRERPOMPD::performSingleStep() {
 
 	// Get player pos at time t.
 	mic::types::Position2D player_pos_t= env.getAgentPosition();
-	LOG(LINFO) << "Agent position at state t: " << player_pos_t;
+	TRACE(TRACE_STEP, LINFO) << "Agent position at state t: " << player_pos_t;
+
+	// Fetch the recently published network.
+	if (learner)
+		updateActorNetwork();
 
 	// Select the action.
 	mic::types::NESWAction action;
@@ -383,7 +487,7 @@ bool MazeOfDigitsDLRERPOMPD::performSingleStep() {
 		eps = 1.0/(1.0+sqrt(episode));
 	if (eps < 0.1)
 		eps = 0.1;
-	LOG(LDEBUG) << "eps = " << eps;
+	TRACE(TRACE_STEP, LDEBUG) << "eps = " << eps;
 	bool random = false;
 
 	// Epsilon-greedy action selection.
@@ -396,12 +500,17 @@ bool MazeOfDigitsDLRERPOMPD::performSingleStep() {
 		random = true;
 	}//: if
 
+	// Encode the observation at time t (required by the asynchronous learner).
+	mic::types::MatrixXfPtr encoded_observation_t;
+	if (learner)
+		encoded_observation_t = env.encodeObservation();
+
 	// Execute action - do not monitor the success.
 	env.moveAgent(action);
 
 	// Get new state s(t+1).
 	mic::types::Position2D player_pos_t_prim = env.getAgentPosition();
-	LOG(LINFO) << "Agent position at t+1: " << player_pos_t_prim << " after performing the action = " << action << ((random) ? " [Random]" : "");
+	TRACE(TRACE_STEP, LINFO) << "Agent position at t+1: " << player_pos_t_prim << " after performing the action = " << action << ((random) ? " [Random]" : "");
 
 	// Add this position to  to saccadic path.
 	saccadic_path->push_back(player_pos_t_prim);
@@ -410,12 +519,29 @@ bool MazeOfDigitsDLRERPOMPD::performSingleStep() {
 	SpatialExperiencePtr exp(new SpatialExperience(player_pos_t, action, player_pos_t_prim));
 	// Create an empty matrix for rewards - this will be recalculated each time the experience will be replayed anyway.
 	MatrixXfPtr rewards (new MatrixXf(4 , batch_size));
-	// Add experience to experience table.
-	experiences.add(exp, rewards);
+	// Compute the reward for the transition - the value of the next state is not bootstrapped if the state is terminal.
+	float reward_t = step_reward;
+	bool chain_end = false;
+	if(env.isStateTerminal(player_pos_t_prim)) {
+		// The position at (t+1) state appears to be terminal - learn the reward.
+		reward_t = env.getStateReward(player_pos_t_prim);
+		chain_end = true;
+	}//: if
+	if (learner) {
+		// Pass the experience in the form of encoded observations to the asynchronous learner.
+		bool allowed_actions_t_prim[4];
+		for (size_t a=0; a<4; a++)
+			allowed_actions_t_prim[a] = env.isActionAllowed(player_pos_t_prim, mic::types::NESWAction((mic::types::NESW)a));
+		ObservationExperiencePtr oexp(new ObservationExperience(encoded_observation_t, action, env.encodeObservation(), allowed_actions_t_prim));
+		observation_chain->addTransition(oexp, reward_t, chain_end);
+	} else {
+		// Add experience to experience table - the discounted rewards are accumulated over the multi-step horizon.
+		experiences.addTransition(exp, rewards, reward_t, chain_end);
+	}//: else
 
 
-	// Deep Q learning - train network with random sample from the experience memory.
-	if (experiences.size() >= 2*batch_size) {
+	// Deep Q learning - train network with random sample from the experience memory (unless it is trained by the asynchronous learner).
+	if ((!learner) && (experiences.size() >= 2*batch_size)) {
 		// Create new matrices for batches of inputs and targets.
 		MatrixXfPtr inputs_t_batch(new MatrixXf(env.getObservationSize(), batch_size));
 		MatrixXfPtr inputs_t_prim_batch(new MatrixXf(env.getObservationSize(), batch_size));
@@ -429,7 +555,7 @@ bool MazeOfDigitsDLRERPOMPD::performSingleStep() {
 		for (size_t i=0; i<batch_size; i++) {
 			SpatialExperienceSample ges = geb.getNextSample();
 			SpatialExperiencePtr ge_ptr = ges.data();
-			LOG(LDEBUG) << "Training sample : " << ge_ptr->s_t << " -> " << ge_ptr->a_t << " -> " << ge_ptr->s_t_prim;
+			TRACE(TRACE_STEP, LDEBUG) << "Training sample : " << ge_ptr->s_t << " -> " << ge_ptr->a_t << " -> " << ge_ptr->s_t_prim;
 		}//: for
 
 		// Iterate through samples and create inputs_t_batch.
@@ -437,6 +563,12 @@ bool MazeOfDigitsDLRERPOMPD::performSingleStep() {
 			SpatialExperienceSample ges = geb.getNextSample();
 			SpatialExperiencePtr ge_ptr = ges.data();
 
+			if (env.hasObservationCache()) {
+				// Gather the cached observation of the state at time (t) - no need to move the player.
+				inputs_t_batch->col(i) = env.getObservationCache()->col(env.getObservationCacheColumn(ge_ptr->s_t));
+				continue;
+			}//: if
+
 			// Replay the experience.
 			// "Simulate" moving player to position from state/time (t).
 			env.moveAgentToPosition(ge_ptr->s_t);
@@ -461,6 +593,12 @@ bool MazeOfDigitsDLRERPOMPD::performSingleStep() {
 			SpatialExperienceSample ges = geb.getNextSample();
 			SpatialExperiencePtr ge_ptr = ges.data();
 
+			if (env.hasObservationCache()) {
+				// Gather the cached observation of the state at time (t+1) - no need to move the player.
+				inputs_t_prim_batch->col(i) = env.getObservationCache()->col(env.getObservationCacheColumn(ge_ptr->s_t_prim));
+				continue;
+			}//: if
+
 			// Replay the experience.
 			// "Simulate" moving player to position from state/time (t+1).
 			env.moveAgentToPosition(ge_ptr->s_t_prim);
@@ -472,10 +610,19 @@ bool MazeOfDigitsDLRERPOMPD::performSingleStep() {
 			inputs_t_prim_batch->col(i) = encoded_state_t->col(0);
 		}// for samples.
 
-		// Get network responses.
-		neural_net.forward(inputs_t_prim_batch);
-		// Get predictions for all those states...
-		MatrixXfPtr predictions_t_prim_batch = neural_net.getPredictions();
+		// Get responses of the target network (if used) for states at time (t+1)...
+		MatrixXfPtr target_predictions_t_prim_batch;
+		if (target_net) {
+			target_net->forward(inputs_t_prim_batch);
+			target_predictions_t_prim_batch = target_net->getPredictions();
+		}//: if
+
+		// ... and responses of the trained network (if required).
+		MatrixXfPtr predictions_t_prim_batch;
+		if ((!target_net) || (double_dqn)) {
+			neural_net.forward(inputs_t_prim_batch);
+			predictions_t_prim_batch = neural_net.getPredictions();
+		}//: if
 
 		// Calculate the rewards, one by one.
 		// Iterate through samples and create inputs_t_prim_batch.
@@ -484,47 +631,52 @@ bool MazeOfDigitsDLRERPOMPD::performSingleStep() {
 			SpatialExperienceSample ges = geb.getNextSample();
 			SpatialExperiencePtr ge_ptr = ges.data();
 
-			/*if (ge_ptr->s_t == ge_ptr->s_t_prim) {
-				// The move was not possible! Learn that as well.
-				(*targets_t_batch)((size_t)ge_ptr->a_t.getType(), i) = 3*step_reward;
-			} else*/
-			if(env.isStateTerminal(ge_ptr->s_t_prim)) {
-				// The position at (t+1) state appears to be terminal - learn the reward.
-				(*targets_t_batch)((size_t)ge_ptr->a_t.getType(), i) = env.getStateReward(ge_ptr->s_t_prim);
+			if (ge_ptr->discount == 0.0f) {
+				// The chain has ended in a terminal state - learn the collected reward.
+				(*targets_t_batch)((size_t)ge_ptr->a_t.getType(), i) = ge_ptr->reward;
 			} else {
-				MatrixXfPtr preds_t_prim (new MatrixXf(4, 1));
-				preds_t_prim->col(0) = predictions_t_prim_batch->col(i);
-				// Get best value for the NEXT state - position from (t+1) state.
-				float max_q_st_prim_at_prim = computeBestValueForGivenStateAndPredictions(ge_ptr->s_t_prim, preds_t_prim->data());
+				// Get best value for the NEXT state - position from (t+n) state.
+				float max_q_st_prim_at_prim;
+				if (!target_net)
+					max_q_st_prim_at_prim = computeBestValueForGivenStateAndPredictions(ge_ptr->s_t_prim, predictions_t_prim_batch->col(i).data());
+				else if (double_dqn)
+					max_q_st_prim_at_prim = computeDoubleQValueForGivenStateAndPredictions(ge_ptr->s_t_prim, predictions_t_prim_batch->col(i).data(), target_predictions_t_prim_batch->col(i).data());
+				else
+					max_q_st_prim_at_prim = computeBestValueForGivenStateAndPredictions(ge_ptr->s_t_prim, target_predictions_t_prim_batch->col(i).data());
 				// If next state best value is finite.
 				// Update running average for given action - Deep Q learning!
 				if (std::isfinite(max_q_st_prim_at_prim))
-					(*targets_t_batch)((size_t)ge_ptr->a_t.getType(), i) = step_reward + discount_rate*max_q_st_prim_at_prim;
+					(*targets_t_batch)((size_t)ge_ptr->a_t.getType(), i) = ge_ptr->reward + ge_ptr->discount*max_q_st_prim_at_prim;
 			}//: else
 
 		}//: for
 
-		LOG(LDEBUG) <<"Inputs batch:\n" << inputs_t_batch->transpose();
-		LOG(LDEBUG) <<"Targets batch:\n" << targets_t_batch->transpose();
+		TRACE(TRACE_DUMP, LDEBUG) <<"Inputs batch:\n" << inputs_t_batch->transpose();
+		TRACE(TRACE_DUMP, LDEBUG) <<"Targets batch:\n" << targets_t_batch->transpose();
 
 		// Perform the Deep-Q-learning.
 		//LOG(LDEBUG) << "Network responses before training:" << std::endl << streamNetworkResponseTable();
 
 		// Train network with rewards.
 		float loss = neural_net.train (inputs_t_batch, targets_t_batch, learning_rate, nn_weight_decay);
-		LOG(LDEBUG) << "Training loss:" << loss;
+		TRACE(TRACE_STEP, LDEBUG) << "Training loss:" << loss;
+
+		// Synchronize the target network every target_update_interval training steps.
+		number_of_training_steps++;
+		if ((target_update_interval > 0) && (number_of_training_steps % (long long)target_update_interval == 0))
+			synchronizeTargetNetwork();
 
 		//LOG(LDEBUG) << "Network responses after training:" << std::endl << streamNetworkResponseTable();
 
 		// Finish the replay: move the player to REAL, CURRENT POSITION.
 		env.moveAgentToPosition(player_pos_t_prim);
 	}//: if enough experiences
-	else
+	else if (!learner)
 		LOG(LWARNING) << "Not enough samples in the experience replay memory!";
 
-	LOG(LNOTICE) << "Network responses: \n" << streamNetworkResponseTable();
-	LOG(LNOTICE) << "Observation: \n"  << env.observationToString();
-	LOG(LNOTICE) << "Environment: \n"  << env.environmentToString();
+	TRACE(TRACE_DUMP, LNOTICE) << "Network responses: \n" << streamNetworkResponseTable();
+	TRACE(TRACE_DUMP, LNOTICE) << "Observation: \n"  << env.observationToString();
+	TRACE(TRACE_DUMP, LNOTICE) << "Environment: \n"  << env.environmentToString();
 	// Do not forget to get the current observation!
 	env.getObservation();
 
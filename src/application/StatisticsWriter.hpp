@@ -0,0 +1,152 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file StatisticsWriter.hpp
+ * \brief Contains declaration (and definition) of the append-only writer of statistics collected by applications.
+ * \author tkornut
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_APPLICATION_STATISTICSWRITER_HPP_
+#define SRC_APPLICATION_STATISTICSWRITER_HPP_
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdint>
+#include <initializer_list>
+
+#include <logger/Log.hpp>
+
+namespace mic {
+namespace application {
+
+/*!
+ * \brief Append-only writer of statistics: rows of values (e.g. one per episode) are buffered and every flush_interval rows
+ * only the new rows are appended to the file, so the cost of export does not grow with the length of the run
+ * (unlike DataCollector::exportDataToCsv(), which rewrites the whole history).
+ * The file is written either as CSV (header with names of columns, then rows) or in the binary format:
+ * uint32 number of columns, for every column uint32 length of its name followed by the name, then rows of float32 values.
+ * \author tkornuta
+ */
+class StatisticsWriter {
+public:
+	/*!
+	 * Constructor. The file is not opened.
+	 */
+	StatisticsWriter() : number_of_columns(0), flush_interval(1), binary(false) { }
+
+	/*!
+	 * Destructor - flushes the remaining rows.
+	 */
+	virtual ~StatisticsWriter() {
+		flush();
+	}
+
+	/*!
+	 * Creates (truncates) the file and writes the header.
+	 * @param filename_ Name of the file.
+	 * @param columns_ Names of the columns.
+	 * @param flush_interval_ Number of rows buffered before they are appended to the file (0 is treated as 1).
+	 * @param binary_ Flag denoting whether the binary format should be used instead of CSV.
+	 */
+	void open(const std::string & filename_, const std::vector<std::string> & columns_, size_t flush_interval_ = 1, bool binary_ = false) {
+		// Flush the rows of the previous file.
+		flush();
+		if (file.is_open())
+			file.close();
+
+		number_of_columns = columns_.size();
+		flush_interval = (flush_interval_ > 0) ? flush_interval_ : 1;
+		binary = binary_;
+		buffer.clear();
+		buffer.reserve(flush_interval * number_of_columns);
+
+		file.open(filename_, binary ? (std::ios::out | std::ios::trunc | std::ios::binary) : (std::ios::out | std::ios::trunc));
+		if (!file.is_open()) {
+			LOG(LERROR) << "Could not open the statistics file " << filename_;
+			return;
+		}//: if
+
+		// Write the header.
+		if (binary) {
+			uint32_t n = (uint32_t)number_of_columns;
+			file.write((const char*)&n, sizeof(n));
+			for (const std::string & column : columns_) {
+				uint32_t length = (uint32_t)column.size();
+				file.write((const char*)&length, sizeof(length));
+				file.write(column.data(), length);
+			}//: for
+		} else {
+			for (size_t i=0; i<number_of_columns; i++)
+				file << ((i > 0) ? "," : "") << columns_[i];
+			file << "\n";
+		}//: else
+		file.flush();
+	}
+
+	/*!
+	 * Adds the row - appends it to the file if the number of buffered rows reached the flush interval.
+	 * @param values_ Values of the row (in the order of columns).
+	 */
+	void addRow(std::initializer_list<float> values_) {
+		if (values_.size() != number_of_columns) {
+			LOG(LWARNING) << "Invalid number of values in the row of statistics (" << values_.size() << " instead of " << number_of_columns << ")";
+			return;
+		}//: if
+		buffer.insert(buffer.end(), values_.begin(), values_.end());
+		if (buffer.size() >= flush_interval * number_of_columns)
+			flush();
+	}
+
+	/*!
+	 * Appends the buffered rows to the file.
+	 */
+	void flush() {
+		if (buffer.empty() || (!file.is_open()))
+			return;
+
+		if (binary)
+			file.write((const char*)buffer.data(), buffer.size() * sizeof(float));
+		else {
+			for (size_t i=0; i<buffer.size(); i++)
+				file << buffer[i] << (((i + 1) % number_of_columns == 0) ? "\n" : ",");
+		}//: else
+		file.flush();
+		buffer.clear();
+	}
+
+private:
+	/// The file.
+	std::ofstream file;
+
+	/// Number of columns.
+	size_t number_of_columns;
+
+	/// Number of rows buffered before they are appended to the file.
+	size_t flush_interval;
+
+	/// Flag denoting whether the binary format is used.
+	bool binary;
+
+	/// Buffered rows.
+	std::vector<float> buffer;
+};
+
+} /* namespace application */
+} /* namespace mic */
+
+#endif /* SRC_APPLICATION_STATISTICSWRITER_HPP_ */
@@ -0,0 +1,49 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file Trace.hpp
+ * \brief Contains the compile-time configurable tracing of the step loops of applications.
+ * \author tkornut
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_APPLICATION_TRACE_HPP_
+#define SRC_APPLICATION_TRACE_HPP_
+
+#include <logger/Log.hpp>
+
+/*!
+ * Level of tracing compiled into the applications (set by the APP_TRACE_LEVEL CMake variable):
+ * 0 - no tracing (the default), TRACE_STEP - values computed in every step, TRACE_DUMP - also dumps of whole tables/environments.
+ */
+#ifndef APP_TRACE_LEVEL
+#define APP_TRACE_LEVEL 0
+#endif
+
+/// Trace level: values computed in every step (positions, actions, rewards etc.).
+#define TRACE_STEP 1
+
+/// Trace level: dumps of whole tables, batches and environments.
+#define TRACE_DUMP 2
+
+/*!
+ * Logs the message with the given severity if the given trace level is compiled in, e.g. TRACE(TRACE_STEP, LDEBUG) << "eps = " << eps;
+ * The condition is a compile-time constant, so the disabled traces (including evaluation of the streamed expressions)
+ * are removed by the compiler, while their code is still type-checked.
+ */
+#define TRACE(level_, severity_) if ((level_) > APP_TRACE_LEVEL) {} else LOG(severity_)
+
+#endif /* SRC_APPLICATION_TRACE_HPP_ */
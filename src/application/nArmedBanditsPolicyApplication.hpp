@@ -0,0 +1,199 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file nArmedBanditsPolicyApplication.hpp
+ * \brief Contains declaration (and definition) of the application solving the n armed bandits problem with a pluggable policy.
+ * \author tkornut
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_APPLICATION_NARMEDBANDITSPOLICYAPPLICATION_HPP_
+#define SRC_APPLICATION_NARMEDBANDITSPOLICYAPPLICATION_HPP_
+
+#include <types/MultiArmedBandit.hpp>
+#include <algorithms/BanditPolicies.hpp>
+#include <application/StatisticsWriter.hpp>
+
+#include <opengl/application/OpenGLApplication.hpp>
+#include <opengl/visualization/WindowCollectorChart.hpp>
+using namespace mic::opengl::visualization;
+
+namespace mic {
+namespace application {
+
+/*!
+ * \brief Application solving the n armed bandits problem with the arm selection policy given as template parameter.
+ * Contains the parts shared by all policies: the bandit (environment), statistics (running mean reward and percentage
+ * of choices of the best arm) and their visualization/export. Every step performs pulls_per_step pulls, so policies can be
+ * compared at high pull rates without the cost of visualization and export of statistics after each pull.
+ * \author tkornuta
+ * \tparam PolicyType Type of the policy (EpsilonGreedyBanditPolicy, SoftmaxBanditPolicy, UCB1BanditPolicy or ThompsonSamplingBanditPolicy).
+ */
+template <class PolicyType>
+class nArmedBanditsPolicyApplication: public mic::opengl::application::OpenGLApplication {
+public:
+	/*!
+	 * Default Constructor. Sets the application/node name, default values of variables etc.
+	 * @param node_name_ Name of the application/node (in configuration file).
+	 */
+	nArmedBanditsPolicyApplication(std::string node_name_ = "application") : OpenGLApplication(node_name_),
+		number_of_bandits("number_of_bandits", 10),
+		pulls_per_step("pulls_per_step", 1),
+		statistics_filename("statistics_filename","statistics_filename.csv"),
+		statistics_flush_interval("statistics_flush_interval", 100),
+		statistics_binary("statistics_binary", false)
+	{
+		// Register properties - so their values can be overridden (read from the configuration file).
+		registerProperty(number_of_bandits);
+		registerProperty(pulls_per_step);
+		registerProperty(statistics_filename);
+		registerProperty(statistics_flush_interval);
+		registerProperty(statistics_binary);
+
+		LOG(LINFO) << "Properties registered";
+	}
+
+	/*!
+	 * Destructor.
+	 */
+	virtual ~nArmedBanditsPolicyApplication() {
+		delete(w_reward);
+	}
+
+protected:
+	/*!
+	 * Method initializes GLUT and OpenGL windows.
+	 * @param argc Number of application parameters.
+	 * @param argv Array of application parameters.
+	 */
+	virtual void initialize(int argc, char* argv[]) {
+		// Initialize GLUT! :]
+		VGL_MANAGER->initializeGLUT(argc, argv);
+
+		reward_collector_ptr = std::make_shared < mic::utils::DataCollector<std::string, float> >( );
+		// Add containers to collector.
+		reward_collector_ptr->createContainer("average_reward", 0, 10, mic::types::color_rgba(255, 0, 0, 180));
+		reward_collector_ptr->createContainer("correct_arms_percentage", 0, 100, mic::types::color_rgba(0, 255, 0, 180));
+		reward_collector_ptr->createContainer("best_possible_reward", 0, 10, mic::types::color_rgba(0, 0, 255, 180));
+
+		// Create the visualization windows - must be created in the same, main thread :]
+		w_reward = new WindowCollectorChart<float>("nBandits", 256, 256, 0, 0);
+		w_reward->setDataCollectorPtr(reward_collector_ptr);
+	}
+
+	/*!
+	 * Initializes all variables that are property-dependent.
+	 */
+	virtual void initializePropertyDependentVariables() {
+		// Initialize the bandit - draw the hidden probabilities of arms.
+		bandit.initializeArms(number_of_bandits);
+		best_arm = bandit.getBestArm();
+
+		// Initialize the policy.
+		policy.initializePolicy(number_of_bandits, bandit.getMaxReward());
+
+		// Reset the statistics.
+		total_reward = 0.0;
+		correct_arm_choices = 0;
+		number_of_pulls = 0;
+
+		// Create the statistics file.
+		statistics_writer.open(statistics_filename, {"average_reward", "correct_arms_percentage", "best_possible_reward"}, statistics_flush_interval, statistics_binary);
+	}
+
+	/*!
+	 * Performs pulls_per_step pulls, then updates the statistics.
+	 */
+	virtual bool performSingleStep() {
+		LOG(LTRACE) << "Performing a single step (" << iteration << ")";
+
+		for (size_t i=0; i<pulls_per_step; i++) {
+			size_t choice = policy.selectArm();
+			float reward = bandit.pull(choice);
+			policy.update(choice, reward);
+
+			total_reward += reward;
+			correct_arm_choices += (choice == best_arm);
+		}//: for
+		number_of_pulls += pulls_per_step;
+
+		// Calculate the percentage the correct arm is chosen.
+		float correct_arms_percentage = 100.0 * correct_arm_choices / number_of_pulls;
+
+		// Calculate the mean reward.
+		float running_mean_reward = total_reward / number_of_pulls;
+
+		float best_possible_reward = bandit.getExpectedReward(best_arm);
+
+		// Add variables to container.
+		reward_collector_ptr->addDataToContainer("average_reward",running_mean_reward);
+		reward_collector_ptr->addDataToContainer("correct_arms_percentage",correct_arms_percentage);
+		reward_collector_ptr->addDataToContainer("best_possible_reward",best_possible_reward);
+
+		// Append the row to the reward "convergence" diagram.
+		statistics_writer.addRow({running_mean_reward, correct_arms_percentage, best_possible_reward});
+
+		return true;
+	}
+
+private:
+	/// Window for displaying average reward.
+	WindowCollectorChart<float>* w_reward;
+
+	/// Reward collector.
+	mic::utils::DataCollectorPtr<std::string, float> reward_collector_ptr;
+
+	/// Append-only writer of the statistics.
+	StatisticsWriter statistics_writer;
+
+	/// n-armed bandit (environment).
+	mic::environments::MultiArmedBandit bandit;
+
+	/// Policy selecting the arms.
+	PolicyType policy;
+
+	/// Property: number of bandits
+	mic::configuration::Property<size_t> number_of_bandits;
+
+	/// Property: number of pulls performed in a single step (i.e. between updates of the visualized/exported statistics).
+	mic::configuration::Property<size_t> pulls_per_step;
+
+	/// Property: name of the file to which the statistics will be exported.
+	mic::configuration::Property<std::string> statistics_filename;
+
+	/// Property: number of rows of statistics buffered before they are appended to the file.
+	mic::configuration::Property<size_t> statistics_flush_interval;
+
+	/// Property: flag denoting whether the statistics should be exported in the binary format (instead of CSV).
+	mic::configuration::Property<bool> statistics_binary;
+
+	/// The best arm (hidden state).
+	size_t best_arm;
+
+	/// Sum of all collected rewards.
+	double total_reward;
+
+	/// Number of choices of the best arm.
+	uint64_t correct_arm_choices;
+
+	/// Number of performed pulls.
+	uint64_t number_of_pulls;
+};
+
+} /* namespace application */
+} /* namespace mic */
+
+#endif /* SRC_APPLICATION_NARMEDBANDITSPOLICYAPPLICATION_HPP_ */
@@ -0,0 +1,224 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file nArmedBanditsTestbed.cpp
+ * \brief Definitions of the methods of the headless application running many independent n-armed bandit problems in parallel.
+ * \author tkornut
+ * \date Oct 18, 2026
+ */
+
+#include <random>
+#include <thread>
+#include <chrono>
+#include <fstream>
+
+#include <application/nArmedBanditsTestbed.hpp>
+
+namespace mic {
+namespace application {
+
+/*!
+ * \brief Registers the application.
+ * \author tkornuta
+ */
+void RegisterApplication (void) {
+	REGISTER_APPLICATION(mic::application::nArmedBanditsTestbed);
+}
+
+
+nArmedBanditsTestbed::nArmedBanditsTestbed(std::string node_name_) : Application(node_name_),
+		number_of_bandits("number_of_bandits", 10),
+		number_of_runs("number_of_runs", 2000),
+		number_of_steps("number_of_steps", 1000),
+		epsilon("epsilon", 0.1),
+		initial_value("initial_value", 0.0),
+		number_of_threads("number_of_threads", 0),
+		seed("seed", -1),
+		statistics_filename("statistics_filename","statistics_filename.csv")
+	{
+	// Register properties - so their values can be overridden (read from the configuration file).
+	registerProperty(number_of_bandits);
+	registerProperty(number_of_runs);
+	registerProperty(number_of_steps);
+	registerProperty(epsilon);
+	registerProperty(initial_value);
+	registerProperty(number_of_threads);
+	registerProperty(seed);
+	registerProperty(statistics_filename);
+
+	LOG(LINFO) << "Properties registered";
+}
+
+
+nArmedBanditsTestbed::~nArmedBanditsTestbed() {
+
+}
+
+
+void nArmedBanditsTestbed::initialize(int argc, char* argv[]) {
+
+}
+
+
+void nArmedBanditsTestbed::initializePropertyDependentVariables() {
+	// Draw the problems of all runs.
+	bandit.initializeArms(number_of_bandits, number_of_runs);
+
+	action_values.assign(number_of_runs * number_of_bandits, initial_value);
+	action_counts.assign(number_of_runs * number_of_bandits, 0);
+	best_arms.resize(number_of_runs);
+	for (size_t i=0; i<number_of_runs; i++)
+		best_arms[i] = bandit.getBestArm(i);
+
+	// Seed the generators of agents - consecutive runs use consecutive streams, following the streams used by the bandit problems
+	// (0 .. number_of_runs-1), so the exploration never repeats the reward noise, even when both seeds are equal.
+	uint64_t s = (seed < 0) ? ((uint64_t)std::random_device()() << 32) ^ std::random_device()() : (uint64_t)seed;
+	rngs.resize(number_of_runs);
+	for (size_t i=0; i<number_of_runs; i++) {
+		if (i == 0)
+			rngs[i].seed(s, number_of_runs);
+		else {
+			rngs[i] = rngs[i-1];
+			rngs[i].jump();
+		}//: else
+	}//: for
+
+	LOG(LSTATUS) << "Generated " << number_of_runs << " bandit problems with " << number_of_bandits << " arms";
+}
+
+
+void nArmedBanditsTestbed::runBand(size_t first_run_, size_t number_of_runs_, double* rewards_curve_, uint32_t* optimal_curve_) {
+	const size_t arms = number_of_bandits;
+	const float eps = (float)epsilon;
+
+	// Choices and rewards of the band in the current step.
+	std::vector<size_t> choices(number_of_runs_);
+	std::vector<float> rewards(number_of_runs_);
+
+	for (size_t t=0; t<number_of_steps; t++) {
+		// Epsilon-greedy selection of arms.
+		for (size_t i=0; i<number_of_runs_; i++) {
+			size_t run = first_run_ + i;
+			const float* q = action_values.data() + run * arms;
+
+			// A single draw provides both the exploration decision (upper bits) and the candidate arm (lower bits).
+			uint64_t x = rngs[run]();
+			float u = (float)(x >> 40) * (1.0f / 16777216.0f);
+			size_t random_arm = (size_t)((x & 0xffffffffULL) % arms);
+
+			// Greedy arm - the scan starts from the random arm, so the ties are broken randomly.
+			size_t greedy_arm = random_arm;
+			float greedy_value = q[random_arm];
+			for (size_t k=1; k<arms; k++) {
+				size_t a = random_arm + k;
+				a = (a < arms) ? a : a - arms;
+				bool better = q[a] > greedy_value;
+				greedy_value = better ? q[a] : greedy_value;
+				greedy_arm = better ? a : greedy_arm;
+			}//: for k
+
+			choices[i] = (u < eps) ? random_arm : greedy_arm;
+		}//: for i
+
+		// Pull the selected arms of all problems of the band.
+		bandit.pullProblems(choices.data(), rewards.data(), first_run_, number_of_runs_);
+
+		// Sample-average update and collection of statistics.
+		double reward_sum = 0.0;
+		uint32_t optimal = 0;
+		for (size_t i=0; i<number_of_runs_; i++) {
+			size_t run = first_run_ + i;
+			size_t idx = run * arms + choices[i];
+			uint32_t n = ++action_counts[idx];
+			action_values[idx] += (rewards[i] - action_values[idx]) / n;
+
+			reward_sum += rewards[i];
+			optimal += (choices[i] == best_arms[run]);
+		}//: for i
+
+		rewards_curve_[t] = reward_sum;
+		optimal_curve_[t] = optimal;
+	}//: for t
+}
+
+
+void nArmedBanditsTestbed::exportStatistics() {
+	std::ofstream file(statistics_filename);
+	file << "step,average_reward,optimal_action_percentage" << std::endl;
+	for (size_t t=0; t<number_of_steps; t++)
+		file << t + 1 << "," << average_rewards[t] << "," << optimal_action_percentages[t] << std::endl;
+	LOG(LINFO) << "Statistics exported to " << (std::string)statistics_filename;
+}
+
+
+bool nArmedBanditsTestbed::performSingleStep() {
+	LOG(LTRACE) << "Performing a single step (" << iteration << ")";
+
+	size_t threads = (number_of_threads > 0) ? (size_t)number_of_threads : std::thread::hardware_concurrency();
+	if (threads == 0)
+		threads = 1;
+	if (threads > number_of_runs)
+		threads = (number_of_runs > 0) ? (size_t)number_of_runs : 1;
+
+	// Every thread has its own band of runs and its own curves - reduced after all threads finish.
+	const size_t T = number_of_steps;
+	std::vector<double> rewards_curves(threads * T, 0.0);
+	std::vector<uint32_t> optimal_curves(threads * T, 0);
+
+	std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+	std::vector<std::thread> workers;
+	for (size_t w=0; w<threads; w++) {
+		size_t first = number_of_runs * w / threads;
+		size_t last = number_of_runs * (w + 1) / threads;
+		workers.push_back(std::thread(&nArmedBanditsTestbed::runBand, this, first, last - first,
+				rewards_curves.data() + w * T, optimal_curves.data() + w * T));
+	}//: for
+	for (std::thread & worker : workers)
+		worker.join();
+	std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+	// Reduce the curves.
+	average_rewards.assign(T, 0.0);
+	optimal_action_percentages.assign(T, 0.0);
+	for (size_t w=0; w<threads; w++) {
+		for (size_t t=0; t<T; t++) {
+			average_rewards[t] += rewards_curves[w * T + t];
+			optimal_action_percentages[t] += optimal_curves[w * T + t];
+		}//: for t
+	}//: for w
+	double best_possible_reward = 0.0;
+	for (size_t i=0; i<number_of_runs; i++)
+		best_possible_reward += bandit.getExpectedReward(best_arms[i], i);
+	double runs = (number_of_runs > 0) ? (double)number_of_runs : 1.0;
+	for (size_t t=0; t<T; t++) {
+		average_rewards[t] /= runs;
+		optimal_action_percentages[t] *= 100.0 / runs;
+	}//: for
+
+	if (T > 0)
+		LOG(LSTATUS) << number_of_runs << " runs, " << T << " steps: final average reward = " << average_rewards[T-1]
+				<< " (best possible = " << best_possible_reward / runs << "), optimal actions = " << optimal_action_percentages[T-1] << "%";
+	LOG(LSTATUS) << "Time = " << elapsed.count() << "s using " << threads << " threads, pulls/sec = " << (number_of_runs * T) / elapsed.count();
+
+	exportStatistics();
+
+	// Done.
+	return false;
+}
+
+
+} /* namespace application */
+} /* namespace mic */
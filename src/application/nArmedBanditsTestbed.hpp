@@ -0,0 +1,146 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file nArmedBanditsTestbed.hpp
+ * \brief Contains declaration of the headless application running many independent n-armed bandit problems in parallel.
+ * \author tkornut
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_APPLICATION_NARMEDBANDITSTESTBED_HPP_
+#define SRC_APPLICATION_NARMEDBANDITSTESTBED_HPP_
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include <application/Application.hpp>
+
+#include <types/MultiArmedBandit.hpp>
+#include <types/Xoshiro256.hpp>
+
+namespace mic {
+namespace application {
+
+/*!
+ * \brief Headless n-armed bandit testbed: number_of_runs independent bandit problems, each solved by its own epsilon-greedy
+ * agent with sample-average action values, are advanced for number_of_steps steps.
+ * The state of the agents is stored in a structure-of-arrays layout (action values and counts of all runs in contiguous rows)
+ * and the runs are split into contiguous bands processed by worker threads. Only the learning curves averaged over all runs
+ * (average reward and percentage of optimal actions in every step) are exported to a CSV file at the end.
+ * \author tkornuta
+ */
+class nArmedBanditsTestbed: public mic::application::Application {
+public:
+	/*!
+	 * Default Constructor. Sets the application/node name, default values of variables etc.
+	 * @param node_name_ Name of the application/node (in configuration file).
+	 */
+	nArmedBanditsTestbed(std::string node_name_ = "application");
+
+	/*!
+	 * Destructor.
+	 */
+	virtual ~nArmedBanditsTestbed();
+
+protected:
+	/*!
+	 * Initializes all variables that are property-dependent - draws the bandit problems of all runs.
+	 */
+	virtual void initializePropertyDependentVariables();
+
+	/*!
+	 * Method empty (not used).
+	 * @param argc Number of application parameters.
+	 * @param argv Array of application parameters.
+	 */
+	virtual void initialize(int argc, char* argv[]);
+
+	/*!
+	 * Performs the whole experiment: number_of_steps steps of all runs, then exports the learning curves.
+	 */
+	virtual bool performSingleStep();
+
+private:
+	/*!
+	 * Performs all steps of the band of runs - called by worker threads (every thread works on a disjoint band).
+	 * @param first_run_ Index of the first run of the band.
+	 * @param number_of_runs_ Number of runs in the band.
+	 * @param rewards_curve_ Output array for sums of rewards collected in the band in consecutive steps.
+	 * @param optimal_curve_ Output array for numbers of optimal actions selected in the band in consecutive steps.
+	 */
+	void runBand(size_t first_run_, size_t number_of_runs_, double* rewards_curve_, uint32_t* optimal_curve_);
+
+	/*!
+	 * Exports the learning curves to the CSV file.
+	 */
+	void exportStatistics();
+
+	/// The bandit object - contains the problems of all runs.
+	mic::environments::MultiArmedBandit bandit;
+
+	/// Property: number of bandits (arms).
+	mic::configuration::Property<size_t> number_of_bandits;
+
+	/// Property: number of independent runs (bandit problems).
+	mic::configuration::Property<size_t> number_of_runs;
+
+	/// Property: number of steps performed in every run.
+	mic::configuration::Property<size_t> number_of_steps;
+
+	/*!
+	 * Property: variable denoting epsilon in action selection (the probability "below" which a random action will be selected).
+	 */
+	mic::configuration::Property<double> epsilon;
+
+	/// Property: initial action values (values greater than the rewards result in the "optimistic" exploration).
+	mic::configuration::Property<float> initial_value;
+
+	/// Property: number of worker threads (0 means the number of hardware threads).
+	mic::configuration::Property<size_t> number_of_threads;
+
+	/*!
+	 * Property: seed of the generators of agents.
+	 * Setting seed < 0 means that the generators will be seeded by std::random_device.
+	 */
+	mic::configuration::Property<long> seed;
+
+	/// Property: name of the file to which the learning curves will be exported.
+	mic::configuration::Property<std::string> statistics_filename;
+
+	/// Action values - [run][arm].
+	std::vector<float> action_values;
+
+	/// Counts of arm selections - [run][arm].
+	std::vector<uint32_t> action_counts;
+
+	/// Best arms - one per run (copied from the bandit, so the inner loop does not call it).
+	std::vector<size_t> best_arms;
+
+	/// Generators of agents (used for exploration) - one per run.
+	std::vector<mic::types::Xoshiro256> rngs;
+
+	/// Average rewards in consecutive steps.
+	std::vector<double> average_rewards;
+
+	/// Percentages of optimal actions in consecutive steps.
+	std::vector<double> optimal_action_percentages;
+};
+
+} /* namespace application */
+} /* namespace mic */
+
+#endif /* SRC_APPLICATION_NARMEDBANDITSTESTBED_HPP_ */
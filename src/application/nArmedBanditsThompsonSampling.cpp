@@ -0,0 +1,43 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file nArmedBanditsThompsonSampling.cpp
+ * \brief Registers the application solving the n armed bandits problem using Thompson sampling (Beta-Bernoulli model).
+ * \author tkornut
+ * \date Oct 18, 2026
+ */
+
+#include <application/nArmedBanditsPolicyApplication.hpp>
+
+namespace mic {
+namespace application {
+
+/*!
+ * \brief Application solving the n armed bandits problem using Thompson sampling (Beta-Bernoulli model).
+ * \author tkornuta
+ */
+typedef nArmedBanditsPolicyApplication<mic::algorithms::ThompsonSamplingBanditPolicy> nArmedBanditsThompsonSampling;
+
+/*!
+ * \brief Registers the application.
+ * \author tkornuta
+ */
+void RegisterApplication (void) {
+	REGISTER_APPLICATION(mic::application::nArmedBanditsThompsonSampling);
+}
+
+} /* namespace application */
+} /* namespace mic */
@@ -20,6 +20,7 @@
  * \date Mar 14, 2016
  */
 
+#include <limits>
 #include  <utils/RandomGenerator.hpp>
 #include <application/nArmedBanditsUnlimitedHistory.hpp>
 
@@ -38,13 +39,19 @@ void RegisterApplication (void) {
 nArmedBanditsUnlimitedHistory::nArmedBanditsUnlimitedHistory(std::string node_name_) : OpenGLApplication(node_name_),
 		number_of_bandits("number_of_bandits", 10),
 		epsilon("epsilon", 0.1),
-		statistics_filename("statistics_filename","statistics_filename.csv")
+		statistics_filename("statistics_filename","statistics_filename.csv"),
+		statistics_flush_interval("statistics_flush_interval", 100),
+		statistics_binary("statistics_binary", false),
+		store_history("store_history", true)
 
 	{
 	// Register properties - so their values can be overridden (read from the configuration file).
 	registerProperty(number_of_bandits);
 	registerProperty(epsilon);
 	registerProperty(statistics_filename);
+	registerProperty(statistics_flush_interval);
+	registerProperty(statistics_binary);
+	registerProperty(store_history);
 
 	LOG(LINFO) << "Properties registered";
 }
@@ -72,63 +79,61 @@ void nArmedBanditsUnlimitedHistory::initialize(int argc, char* argv[]) {
 }
 
 void nArmedBanditsUnlimitedHistory::initializePropertyDependentVariables() {
-	// Initialize random "arm" thresholds.
-	arms.resize(number_of_bandits);
-	for(size_t i=0; i<number_of_bandits; i++)
-		arms[i] = RAN_GEN->uniRandReal();
-	//std::cout << arms << std:: endl;
+	// Initialize the bandit - draw the hidden probabilities of arms.
+	bandit.initializeArms(number_of_bandits);
 
 	// Find the best arm.
-	best_arm = -1;
-	best_arm_prob = -1;
-	for (size_t i=0; i<number_of_bandits; i++) {
-		if (arms[i] > best_arm_prob){
-			best_arm_prob = arms[i];
-			best_arm = i;
-		}//: if
-	}//: for
+	best_arm = bandit.getBestArm();
+
+	// Reset the statistics.
+	arm_reward_sums.assign(number_of_bandits, 0);
+	arm_counts.assign(number_of_bandits, 0);
+	total_reward = 0;
+	correct_arm_choices = 0;
+	number_of_choices = 0;
+	action_values.clear();
 
 	// Initialize action value - add single row with random action index and value of 0.
-	action_values.push_back(std::make_pair(RAN_GEN->uniRandInt(0, number_of_bandits-1), 0));
+	addActionValue(RAN_GEN->uniRandInt(0, number_of_bandits-1), 0);
+	// The initial row is not a real choice.
+	number_of_choices = 0;
 
+	// Create the statistics file.
+	statistics_writer.open(statistics_filename, {"average_reward", "correct_arms_percentage", "best_possible_reward"}, statistics_flush_interval, statistics_binary);
 }
 
-short nArmedBanditsUnlimitedHistory::calculateReward(float prob_) {
-    short reward = 0;
-	for(size_t i=0; i<number_of_bandits; i++) {
-        if (RAN_GEN->uniRandReal() < prob_)
-            reward += 1;
-	}//: for
-    return reward;
+void nArmedBanditsUnlimitedHistory::addActionValue(size_t arm_, float reward_) {
+	arm_reward_sums[arm_] += reward_;
+	arm_counts[arm_]++;
+	total_reward += reward_;
+	if (arm_ == best_arm)
+		correct_arm_choices++;
+	number_of_choices++;
+
+	// Store the pair in the compressed history.
+	if (store_history)
+		action_values.push_back(std::make_pair((uint32_t)arm_, reward_));
 }
 
 
 size_t nArmedBanditsUnlimitedHistory::selectBestArm() {
 
-	// greedy method to select best arm based on memory array (historical results)
+	// greedy method to select best arm based on the mean rewards of arms
     size_t current_best_arm = 0;
-    float current_best_mean = -1;
+    float current_best_mean = -std::numeric_limits<float>::infinity();
     // For all possible arms.
 	for(size_t i=0; i<number_of_bandits; i++) {
-		long sum = 0;
-		long no_actions=0;
-		for(auto av: action_values){
-			if (av.first == i) {
-				sum += av.second;
-				no_actions ++;
-			}
-		}//: for all action values
+		// Skip the arms that were never chosen.
+		if (arm_counts[i] == 0)
+			continue;
 		// Calculate mean reward for each action.
-		float mean_reward = (float) sum/no_actions;
-		//std::cout<< "mean_reward ["<< i <<"] = " << mean_reward <<std::endl;
+		float mean_reward = (float) arm_reward_sums[i]/arm_counts[i];
 		// Check if this one is better than the others.
 		if (mean_reward > current_best_mean) {
 			current_best_mean = mean_reward;
 			current_best_arm = i;
-			//std::cout<< "found best reward = " << best_mean <<" for arm" << best_arm <<std::endl;
 		}//: if
 	}//: for
-	//std::cout<< "best arm = " << best_arm <<std::endl;
     return current_best_arm;
 }
 
@@ -148,36 +153,25 @@ bool nArmedBanditsUnlimitedHistory::performSingleStep() {
 	}//: if
 
 	// Calculate reward.
-	//std::cout << "choice = " << choice << " arms[choice]=" << arms[choice] << std::endl;
-	short reward = calculateReward(arms[choice]);
+	float reward = bandit.pull(choice);
 	// Add results to the memory.
-	action_values.push_back(std::make_pair(choice, reward));
+	addActionValue(choice, reward);
 
 	// Calculate the percentage the correct arm is chosen.
-//	std::cout<< "correct arm/choice=" << best_arm << std::endl;
-	size_t correct_arm =0;
-	for(auto av: action_values){
-		if (av.first == best_arm)
-			correct_arm++;
-	}//: for all action values
-	float correct_arms_percentage = 100.0*correct_arm/(action_values.size()-1);
+	float correct_arms_percentage = 100.0*correct_arm_choices/number_of_choices;
 
 	// Calculate the mean reward.
-	float running_mean_reward = 0;
-	//std::cout << "action_values= \n";
-	for(auto av: action_values){
-		//std::cout << av.first << ", " << av.second << std::endl;
-		running_mean_reward += av.second;
-	}//: for all action values
-	running_mean_reward /= (action_values.size()-1);
+	float running_mean_reward = (float)total_reward/number_of_choices;
+
+	float best_possible_reward = bandit.getExpectedReward(best_arm);
 
 	// Add variables to container.
 	reward_collector_ptr->addDataToContainer("average_reward",running_mean_reward);
 	reward_collector_ptr->addDataToContainer("correct_arms_percentage",correct_arms_percentage);
-	reward_collector_ptr->addDataToContainer("best_possible_reward",10.0*best_arm_prob);
+	reward_collector_ptr->addDataToContainer("best_possible_reward",best_possible_reward);
 
-	// Export reward "convergence" diagram.
-	reward_collector_ptr->exportDataToCsv(statistics_filename);
+	// Append the row to the reward "convergence" diagram.
+	statistics_writer.addRow({running_mean_reward, correct_arms_percentage, best_possible_reward});
 
 	return true;
 }
@@ -24,11 +24,14 @@
 #define SRC_APPLICATION_NARMEDBANDITSUNLIMITEDHISTORY_HPP_
 
 #include <vector>
+#include <cstdint>
 
 #include <types/MatrixTypes.hpp>
+#include <types/MultiArmedBandit.hpp>
 
 #include <opengl/application/OpenGLApplication.hpp>
 #include <opengl/visualization/WindowCollectorChart.hpp>
+#include <application/StatisticsWriter.hpp>
 using namespace mic::opengl::visualization;
 
 namespace mic {
@@ -77,11 +80,32 @@ private:
 	/// Reward collector.
 	mic::utils::DataCollectorPtr<std::string, float> reward_collector_ptr;
 
-	/// n Bandit arms.
-	mic::types::VectorXf arms;
+	/// Append-only writer of the statistics.
+	StatisticsWriter statistics_writer;
 
-	/// Action values - pairs of <arm_number, reward>.
-	std::vector< std::pair<size_t, size_t> > action_values;
+	/// n-armed bandit (environment).
+	mic::environments::MultiArmedBandit bandit;
+
+	/*!
+	 * Compact history of action values - pairs of <arm_number, reward> (8 bytes per pair).
+	 * Not used by the action selection, stored (if required) only for replay/analysis.
+	 */
+	std::vector< std::pair<uint32_t, float> > action_values;
+
+	/// Sums of rewards collected by every arm.
+	std::vector<double> arm_reward_sums;
+
+	/// Number of times every arm was chosen.
+	std::vector<long> arm_counts;
+
+	/// Sum of all collected rewards.
+	double total_reward;
+
+	/// Number of times the best arm was chosen.
+	long correct_arm_choices;
+
+	/// Number of performed choices.
+	long number_of_choices;
 
 	/// Property: number of bandits.
 	mic::configuration::Property<size_t> number_of_bandits;
@@ -92,26 +116,32 @@ private:
 	/// Property: name of the file to which the statistics will be exported.
 	mic::configuration::Property<std::string> statistics_filename;
 
+	/// Property: number of rows of statistics buffered before they are appended to the file.
+	mic::configuration::Property<size_t> statistics_flush_interval;
+
+	/// Property: flag denoting whether the statistics should be exported in the binary format (instead of CSV).
+	mic::configuration::Property<bool> statistics_binary;
+
+	/// Property: flag denoting whether the (compact) history of all action-value pairs should be stored.
+	mic::configuration::Property<bool> store_history;
+
 	/*!
 	 * The best arm (hidden state).
 	 */
 	size_t best_arm;
 
-	/*!
-	 * The best arm probability/"reward" (hidden state).
-	 */
-	float best_arm_prob;
 
 	/*!
-	 * Calculates the reward.
-	 * @param prob_ Probability.
+	 * Greedy method that selects best arm based on the mean rewards of arms (incrementally updated statistics of the historical action-value pairs).
 	 */
-	short calculateReward(float prob_);
+	size_t selectBestArm();
 
 	/*!
-	 * Greedy method that selects best arm based on historical action-value pairs.
+	 * Adds the action-value pair to the history - updates the statistics of the arm and (optionally) stores the pair.
+	 * @param arm_ Chosen arm.
+	 * @param reward_ Collected reward.
 	 */
-	size_t selectBestArm();
+	void addActionValue(size_t arm_, float reward_);
 
 
 };
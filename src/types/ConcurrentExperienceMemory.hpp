@@ -0,0 +1,215 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file ConcurrentExperienceMemory.hpp
+ * \brief Contains declaration of a sharded experience memory supporting concurrent inserts from many producers.
+ * \author tkornut
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_TYPES_CONCURRENTEXPERIENCEMEMORY_HPP_
+#define SRC_TYPES_CONCURRENTEXPERIENCEMEMORY_HPP_
+
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <random>
+
+namespace mic {
+namespace types {
+
+/*!
+ * \brief Experience memory supporting concurrent inserts from multiple producer threads (actors) and random sampling by a consumer (learner).
+ * The memory is divided into shards, each guarded by its own mutex. Consecutive inserts are distributed among the shards in a round-robin manner
+ * (so the shards are filled evenly independently of the number of producers) and a producer moves to the next shard if the selected one
+ * is currently locked, so producers rarely wait for each other.
+ * Sampling is uniform over all stored experiences: the indices are drawn from the snapshot of shard sizes
+ * and each shard is locked once per batch.
+ * \author tkornuta
+ * \tparam T Type of the stored experience.
+ */
+template <typename T>
+class ConcurrentExperienceMemory {
+public:
+	/*!
+	 * Constructor.
+	 * @param number_of_experiences_ The size of the memory (maximum number of stored experiences).
+	 * @param number_of_shards_ Number of shards (default: 16).
+	 */
+	ConcurrentExperienceMemory(size_t number_of_experiences_, size_t number_of_shards_ = 16) :
+		next_shard(0), sampling_rng(std::random_device()())
+	{
+		if (number_of_shards_ == 0)
+			number_of_shards_ = 1;
+		if (number_of_shards_ > number_of_experiences_)
+			number_of_shards_ = (number_of_experiences_ > 0) ? number_of_experiences_ : 1;
+		// Round up, so the total capacity is not smaller than requested.
+		shard_capacity = (number_of_experiences_ + number_of_shards_ - 1) / number_of_shards_;
+		if (shard_capacity == 0)
+			shard_capacity = 1;
+
+		std::random_device rd;
+		for (size_t i=0; i<number_of_shards_; i++)
+			shards.push_back(std::unique_ptr<Shard>(new Shard(shard_capacity, rd())));
+	}
+
+	/*!
+	 * Adds experience to the memory.
+	 * If the shard is full it replaces a random experience stored in that shard.
+	 * @param exp_ Experience to be added.
+	 */
+	void add(std::shared_ptr<T> exp_) {
+		size_t first = next_shard.fetch_add(1, std::memory_order_relaxed) % shards.size();
+
+		// Try to find a free shard, starting from the selected one...
+		for (size_t i=0; i<shards.size(); i++) {
+			Shard & shard = *shards[(first + i) % shards.size()];
+			std::unique_lock<std::mutex> lock(shard.mtx, std::try_to_lock);
+			if (lock.owns_lock()) {
+				shard.add(exp_);
+				return;
+			}//: if
+		}//: for
+
+		// ... all shards are busy - wait for the selected one.
+		Shard & shard = *shards[first];
+		std::lock_guard<std::mutex> lock(shard.mtx);
+		shard.add(exp_);
+	}
+
+	/*!
+	 * Returns the number of stored experiences.
+	 */
+	size_t size() {
+		size_t total = 0;
+		for (const std::unique_ptr<Shard> & shard : shards)
+			total += shard->size.load(std::memory_order_acquire);
+		return total;
+	}
+
+	/*!
+	 * Returns the maximum number of stored experiences.
+	 */
+	size_t capacity() {
+		return shard_capacity * shards.size();
+	}
+
+	/*!
+	 * Returns a batch of experiences drawn uniformly (with replacement) from all stored experiences.
+	 * @param batch_size_ The size of the batch.
+	 * @return Vector of experiences (empty if the memory is empty).
+	 */
+	std::vector<std::shared_ptr<T> > getRandomBatch(size_t batch_size_) {
+		std::vector<std::shared_ptr<T> > batch;
+
+		// Take the snapshot of sizes - shards only grow, so the drawn indices remain valid.
+		std::vector<size_t> offsets(shards.size() + 1, 0);
+		for (size_t s=0; s<shards.size(); s++)
+			offsets[s+1] = offsets[s] + shards[s]->size.load(std::memory_order_acquire);
+		if (offsets.back() == 0)
+			return batch;
+
+		// Draw the indices and assign them to shards.
+		std::vector<std::vector<size_t> > shard_indices(shards.size());
+		{
+			std::lock_guard<std::mutex> lock(sampling_mtx);
+			std::uniform_int_distribution<size_t> index_dist(0, offsets.back()-1);
+			for (size_t i=0; i<batch_size_; i++) {
+				size_t index = index_dist(sampling_rng);
+				size_t s = std::upper_bound(offsets.begin(), offsets.end(), index) - offsets.begin() - 1;
+				shard_indices[s].push_back(index - offsets[s]);
+			}//: for
+		}
+
+		// Collect experiences - lock each shard only once.
+		batch.reserve(batch_size_);
+		for (size_t s=0; s<shards.size(); s++) {
+			if (shard_indices[s].empty())
+				continue;
+			std::lock_guard<std::mutex> lock(shards[s]->mtx);
+			for (size_t index : shard_indices[s])
+				batch.push_back(shards[s]->experiences[index]);
+		}//: for
+
+		return batch;
+	}
+
+private:
+	/*!
+	 * \brief Single shard of the memory.
+	 */
+	struct Shard {
+		/// Mutex guarding the shard.
+		std::mutex mtx;
+
+		/// Stored experiences.
+		std::vector<std::shared_ptr<T> > experiences;
+
+		/// Number of stored experiences - can be read without locking.
+		std::atomic<size_t> size;
+
+		/// Capacity of the shard.
+		size_t capacity;
+
+		/// Random generator used for selection of experiences to be replaced.
+		std::mt19937_64 rng;
+
+		/*!
+		 * Constructor.
+		 * @param capacity_ Capacity of the shard.
+		 * @param seed_ Seed of the random generator.
+		 */
+		Shard(size_t capacity_, size_t seed_) : size(0), capacity(capacity_), rng(seed_) {
+			experiences.reserve(capacity);
+		}
+
+		/*!
+		 * Adds experience to the shard - must be called with the shard locked.
+		 * @param exp_ Experience to be added.
+		 */
+		void add(std::shared_ptr<T> & exp_) {
+			if (experiences.size() < capacity) {
+				experiences.push_back(exp_);
+				size.store(experiences.size(), std::memory_order_release);
+			} else {
+				std::uniform_int_distribution<size_t> index_dist(0, capacity-1);
+				experiences[index_dist(rng)] = exp_;
+			}//: else
+		}
+	};
+
+	/// Shards of the memory.
+	std::vector<std::unique_ptr<Shard> > shards;
+
+	/// Capacity of a single shard.
+	size_t shard_capacity;
+
+	/// Counter used for the round-robin selection of shards.
+	std::atomic<size_t> next_shard;
+
+	/// Mutex guarding the sampling random generator.
+	std::mutex sampling_mtx;
+
+	/// Random generator used for sampling.
+	std::mt19937_64 sampling_rng;
+};
+
+} /* namespace types */
+} /* namespace mic */
+
+#endif /* SRC_TYPES_CONCURRENTEXPERIENCEMEMORY_HPP_ */
@@ -22,6 +22,10 @@
 
 #include <types/Environment.hpp>
 
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+
 namespace mic {
 namespace environments {
 
@@ -29,15 +33,29 @@ Environment::Environment(std::string node_name_) : PropertyTree(node_name_),
 		width("width", 4),
 		height("height", 4),
 		roi_size("roi_size", 0),
+		seed("seed", -1),
+		incremental_observation("incremental_observation", true),
+		observation_cache("observation_cache", false),
 		environment_grid(new mic::types::TensorXf()),
-		observation_grid(new mic::types::TensorXf())
+		observation_grid(new mic::types::TensorXf()),
+		cached_observations(new mic::types::MatrixXf())
 {
 	// Register properties - so their values can be overridden (read from the configuration file).
 	registerProperty(width);
 	registerProperty(height);
 	registerProperty(roi_size);
+	registerProperty(seed);
+	registerProperty(incremental_observation);
+	registerProperty(observation_cache);
 
 	pomdp_flag = 0;
+	rng_stream = 0;
+	rng_reseed = true;
+	padding = padded_width = padded_height = 0;
+	padded_grid_dirty = true;
+	observation_valid = false;
+	observed_first_channel = observed_channels = 0;
+	observation_cache_valid = false;
 }
 
 Environment::~Environment() {
@@ -45,6 +63,183 @@ Environment::~Environment() {
 }
 
 
+void Environment::copyEnvironment(const mic::environments::Environment & env_) {
+	// Copy size.
+	width = env_.width;
+	height = env_.height;
+	roi_size = env_.roi_size;
+	incremental_observation = env_.incremental_observation;
+	observation_cache = env_.observation_cache;
+	channels = env_.channels;
+	pomdp_flag = env_.pomdp_flag;
+	initial_position = env_.initial_position;
+	// Copy the random generator (along with its state), so the copy continues the same sequence.
+	seed = env_.seed;
+	rng = env_.rng;
+	rng_stream = env_.rng_stream;
+	rng_reseed = env_.rng_reseed;
+	// Deep copy the grids - into the existing tensors, so the pointers returned earlier (e.g. set in visualization windows) remain valid.
+	(*environment_grid) = (*env_.environment_grid);
+	(*observation_grid) = (*env_.observation_grid);
+	// The padded grid will be rebuilt from the copied environment.
+	invalidatePaddedGrid();
+	// Copy the observation cache - e.g. environments pre-generated in the background come with their observations encoded.
+	(*cached_observations) = (*env_.cached_observations);
+	observation_cache_valid = env_.observation_cache_valid;
+}
+
+
+void Environment::setRandomStream(size_t stream_) {
+	rng_stream = stream_;
+	rng_reseed = true;
+}
+
+
+mic::types::Xoshiro256 & Environment::getRandomGenerator() {
+	if (rng_reseed) {
+		uint64_t s = (seed < 0) ? ((uint64_t)std::random_device()() << 32) ^ std::random_device()() : (uint64_t)seed;
+		rng.seed(s, rng_stream);
+		rng_reseed = false;
+	}//: if
+	return rng;
+}
+
+
+mic::types::Position2D Environment::randomPosition(long min_x_, long max_x_, long min_y_, long max_y_) {
+	mic::types::Xoshiro256 & gen = getRandomGenerator();
+	std::uniform_int_distribution<long> x_dist(min_x_, max_x_);
+	std::uniform_int_distribution<long> y_dist(min_y_, max_y_);
+	mic::types::Position2D pos;
+	pos.x = x_dist(gen);
+	pos.y = y_dist(gen);
+	return pos;
+}
+
+
+void Environment::updatePaddedGrid() {
+	if (!padded_grid_dirty)
+		return;
+
+	// Get the environment - some environments materialize it on demand.
+	const float* src = getEnvironment()->data();
+
+	padding = roi_size / 2;
+	padded_width = width + 2 * padding;
+	padded_height = height + 2 * padding;
+	padded_grid.resize(padded_width * padded_height * channels);
+
+	for (size_t c=0; c<channels; c++) {
+		float* plane = padded_grid.data() + c * padded_width * padded_height;
+		// Fill the whole plane with the padding value, then copy the rows of the environment into its interior.
+		std::fill(plane, plane + padded_width * padded_height, getPaddingValue(c));
+		for (size_t y=0; y<height; y++)
+			std::memcpy(plane + (y + padding) * padded_width + padding, src + (c * height + y) * width, width * sizeof(float));
+	}//: for c
+
+	padded_grid_dirty = false;
+}
+
+
+void Environment::extractObservation(mic::types::Position2D pos_, size_t first_channel_, size_t number_of_channels_) {
+	if (roi_size == 0)
+		return;
+	updatePaddedGrid();
+
+	// Upper-left corner of the ROI in the padded grid - the border is wide enough for every position of the agent.
+	size_t delta = (roi_size-1)/2;
+	size_t x0 = (size_t)pos_.x + padding - delta;
+	size_t y0 = (size_t)pos_.y + padding - delta;
+
+	long dx = pos_.x - observed_position.x;
+	long dy = pos_.y - observed_position.y;
+	if ((incremental_observation) && (observation_valid) && (std::abs(dx) + std::abs(dy) <= 1) &&
+			(first_channel_ == observed_first_channel) && (number_of_channels_ == observed_channels)) {
+		shiftObservation(dx, dy, x0, y0);
+	} else {
+		float* dst = observation_grid->data();
+		for (size_t c=0; c<number_of_channels_; c++) {
+			const float* plane = padded_grid.data() + (first_channel_ + c) * padded_width * padded_height;
+			for (size_t oy=0; oy<roi_size; oy++)
+				std::memcpy(dst + (c * roi_size + oy) * roi_size, plane + (y0 + oy) * padded_width + x0, roi_size * sizeof(float));
+		}//: for c
+	}//: else
+
+	observation_valid = true;
+	observed_position = pos_;
+	observed_first_channel = first_channel_;
+	observed_channels = number_of_channels_;
+	changed_cells.clear();
+}
+
+
+void Environment::shiftObservation(long dx_, long dy_, size_t x0_, size_t y0_) {
+	size_t plane_size = padded_width * padded_height;
+	size_t window_size = roi_size * roi_size;
+
+	for (size_t c=0; c<observed_channels; c++) {
+		float* window = observation_grid->data() + c * window_size;
+		const float* plane = padded_grid.data() + (observed_first_channel + c) * plane_size;
+
+		if (dy_ > 0) {
+			// Shift rows up, read the last row.
+			std::memmove(window, window + roi_size, (window_size - roi_size) * sizeof(float));
+			std::memcpy(window + window_size - roi_size, plane + (y0_ + roi_size - 1) * padded_width + x0_, roi_size * sizeof(float));
+		} else if (dy_ < 0) {
+			// Shift rows down, read the first row.
+			std::memmove(window + roi_size, window, (window_size - roi_size) * sizeof(float));
+			std::memcpy(window, plane + y0_ * padded_width + x0_, roi_size * sizeof(float));
+		} else if (dx_ > 0) {
+			// Shift columns left (the elements wrapping between rows land in the last column), read the last column.
+			std::memmove(window, window + 1, (window_size - 1) * sizeof(float));
+			for (size_t oy=0; oy<roi_size; oy++)
+				window[oy * roi_size + roi_size - 1] = plane[(y0_ + oy) * padded_width + x0_ + roi_size - 1];
+		} else if (dx_ < 0) {
+			// Shift columns right (the elements wrapping between rows land in the first column), read the first column.
+			std::memmove(window + 1, window, (window_size - 1) * sizeof(float));
+			for (size_t oy=0; oy<roi_size; oy++)
+				window[oy * roi_size] = plane[(y0_ + oy) * padded_width + x0_];
+		}//: else
+	}//: for c
+
+	// Refresh the cells changed since the previous extraction (e.g. the old and new position of the agent) that lie inside the ROI.
+	for (size_t index : changed_cells) {
+		size_t c = index / plane_size;
+		size_t py = (index % plane_size) / padded_width;
+		size_t px = index % padded_width;
+		if ((c < observed_first_channel) || (c >= observed_first_channel + observed_channels))
+			continue;
+		if ((px < x0_) || (px >= x0_ + roi_size) || (py < y0_) || (py >= y0_ + roi_size))
+			continue;
+		observation_grid->data()[(c - observed_first_channel) * window_size + (py - y0_) * roi_size + (px - x0_)] = padded_grid[index];
+	}//: for
+}
+
+
+void Environment::buildObservationCache() {
+	observation_cache_valid = false;
+	if ((!observation_cache) || (!pomdp_flag))
+		return;
+
+	size_t observation_size = getObservationSize();
+	cached_observations->resize(observation_size, width * height);
+	cached_observations->setZero();
+
+	// Visit all positions row by row - consecutive observations are updated incrementally.
+	mic::types::Position2D agent = getAgentPosition();
+	for (size_t y=0; y<height; y++) {
+		for (size_t x=0; x<width; x++) {
+			mic::types::Position2D pos(x, y);
+			if (!moveAgentToPosition(pos))
+				continue;
+			std::memcpy(cached_observations->data() + getObservationCacheColumn(pos) * observation_size, getObservation()->data(), observation_size * sizeof(float));
+		}//: for x
+	}//: for y
+	moveAgentToPosition(agent);
+
+	observation_cache_valid = true;
+}
+
+
 bool Environment::moveAgent (mic::types::Action2DInterface ac_) {
 	mic::types::Position2D cur_pos = getAgentPosition();
 	LOG(LDEBUG) << "Current agent position = " << cur_pos;
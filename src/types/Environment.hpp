@@ -23,9 +23,13 @@
 #ifndef SRC_TYPES_ENVIRONMENT_HPP_
 #define SRC_TYPES_ENVIRONMENT_HPP_
 
+#include <random>
+#include <vector>
+
 #include <types/Position2D.hpp>
 #include <types/TensorTypes.hpp>
 #include <types/MatrixTypes.hpp>
+#include <types/Xoshiro256.hpp>
 #include <logger/Log.hpp>
 
 #include <configuration/PropertyTree.hpp>
@@ -60,7 +64,7 @@ public:
 	 * Returns the tensor storing the environment.
 	 * @return Tensor storing the environment.
 	 */
-	mic::types::TensorXfPtr & getEnvironment() { return environment_grid; }
+	virtual mic::types::TensorXfPtr & getEnvironment() { return environment_grid; }
 
 	/*!
 	 * Returns current width of the environment.
@@ -111,6 +115,13 @@ public:
 	size_t getROISize() { return roi_size; }
 
 
+	/*!
+	 * Selects the stream of the random generator used in generation of the environment - parallel workers should use different streams.
+	 * The generator is reseeded (with the seed property) before the next generation.
+	 * @param stream_ Index of the stream.
+	 */
+	void setRandomStream(size_t stream_);
+
 	/*!
 	 * Returns the current state of the environment in the form of a string.
 	 * @return String with description of the environment.
@@ -136,6 +147,31 @@ public:
 	 */
 	virtual mic::types::MatrixXfPtr encodeObservation() = 0;
 
+	/*!
+	 * Returns the tensor being the current observation.
+	 * @return Observation tensor.
+	 */
+	virtual mic::types::TensorXfPtr getObservation() = 0;
+
+	/*!
+	 * Checks whether the observations of the current episode are cached.
+	 * @return True if the cache is valid.
+	 */
+	bool hasObservationCache() { return observation_cache_valid; }
+
+	/*!
+	 * Returns the cached (encoded) observations of all positions of the current episode.
+	 * @return Matrix of size [observation_size, width * height], column y * width + x holds the observation taken in (x,y).
+	 */
+	mic::types::MatrixXfPtr getObservationCache() { return cached_observations; }
+
+	/*!
+	 * Returns the index of the column of the observation cache holding the observation taken in the given position.
+	 * @param pos_ Position of the agent.
+	 * @return Index of the column.
+	 */
+	size_t getObservationCacheColumn(mic::types::Position2D pos_) { return (size_t)pos_.y * width + (size_t)pos_.x; }
+
 	/*!
 	 * Calculates the agent position.
 	 * @return Agent position.
@@ -231,6 +267,96 @@ public:
 
 protected:
 
+	/*!
+	 * Copies the sizes, ROI and the current state of the environment passed as argument.
+	 * Makes deep copies of the environment and observation grids, so the copy can be used independently of the original (e.g. in another thread).
+	 * The grids are copied into the already allocated tensors, hence the pointers returned by getEnvironment() and getObservation() remain valid.
+	 * @param env_ Environment to be copied.
+	 */
+	void copyEnvironment(const mic::environments::Environment & env_);
+
+	/*!
+	 * Returns the random generator of the environment - seeds it at the first use after the change of the seed or stream.
+	 * @return Random generator.
+	 */
+	mic::types::Xoshiro256 & getRandomGenerator();
+
+	/*!
+	 * Draws a random position from the given (inclusive) ranges using the generator of the environment.
+	 * @param min_x_ Minimal x coordinate.
+	 * @param max_x_ Maximal x coordinate.
+	 * @param min_y_ Minimal y coordinate.
+	 * @param max_y_ Maximal y coordinate.
+	 * @return Random position.
+	 */
+	mic::types::Position2D randomPosition(long min_x_, long max_x_, long min_y_, long max_y_);
+
+	/*!
+	 * Rebuilds the padded grid from the environment grid (if it is out of sync).
+	 */
+	void updatePaddedGrid();
+
+	/*!
+	 * Fills the observation cache (if enabled) by taking the observation in every allowed position, then moves the agent back.
+	 * Should be called at the end of the initialization of environments that do not change (apart from the agent) within an episode.
+	 */
+	void buildObservationCache();
+
+	/*!
+	 * Returns the value of the given channel outside of the environment boundaries (used for padding of the ROI).
+	 * @param channel_ Index of the channel.
+	 * @return Padding value (zero by default).
+	 */
+	virtual float getPaddingValue(size_t channel_) { return 0.0f; }
+
+	/*!
+	 * Marks the padded grid as out of sync - it will be rebuilt from the environment grid before the next extraction of the observation.
+	 * Must be called after every change of the environment other than setPaddedCell().
+	 */
+	inline void invalidatePaddedGrid() { padded_grid_dirty = true; observation_valid = false; }
+
+	/*!
+	 * Updates a single cell of the padded grid (if it is in sync) - used e.g. for the cheap update of the agent position.
+	 * The cell is remembered, so it will be refreshed in the incrementally updated observation.
+	 * @param x_ X coordinate (in the environment).
+	 * @param y_ Y coordinate (in the environment).
+	 * @param channel_ Index of the channel.
+	 * @param value_ New value of the cell.
+	 */
+	inline void setPaddedCell(long x_, long y_, size_t channel_, float value_) {
+		if (padded_grid_dirty)
+			return;
+		size_t index = (channel_ * padded_height + (size_t)y_ + padding) * padded_width + (size_t)x_ + padding;
+		padded_grid[index] = value_;
+		if (!observation_valid)
+			return;
+		// Too many changes - the next observation will be copied from scratch.
+		if (changed_cells.size() >= roi_size * roi_size)
+			observation_valid = false;
+		else
+			changed_cells.push_back(index);
+	}
+
+	/*!
+	 * Copies the ROI centered in the given position into the observation grid.
+	 * The ROI is read from the padded grid, so no boundary checks are required and every (channel, row) of the ROI is a single memcpy.
+	 * In the incremental mode, when the center moved by (at most) one cell since the previous extraction, the previous observation
+	 * is shifted by the move (a single memmove per channel) and only the newly exposed row/column and the changed cells are read.
+	 * @param pos_ Center of the ROI.
+	 * @param first_channel_ First channel of the environment copied into the observation.
+	 * @param number_of_channels_ Number of copied channels.
+	 */
+	void extractObservation(mic::types::Position2D pos_, size_t first_channel_, size_t number_of_channels_);
+
+	/*!
+	 * Shifts the observation by the move of its center and fills the newly exposed row or column from the padded grid.
+	 * @param dx_ Move along the x axis (-1, 0 or 1).
+	 * @param dy_ Move along the y axis (-1, 0 or 1, when dx_ is 0).
+	 * @param x0_ X coordinate of the upper-left corner of the (new) ROI in the padded grid.
+	 * @param y0_ Y coordinate of the upper-left corner of the (new) ROI in the padded grid.
+	 */
+	void shiftObservation(long dx_, long dy_, size_t x0_, size_t y0_);
+
 	/// Property: width of the environment.
 	mic::configuration::Property<size_t> width;
 
@@ -240,6 +366,24 @@ protected:
 	/// Property: size of the ROI (region of interest).
 	mic::configuration::Property<size_t> roi_size;
 
+	/*!
+	 * Property: seed of the random generator used in generation of the environment.
+	 * Setting seed < 0 means that the generator will be seeded by std::random_device (i.e. the generated environments are not reproducible).
+	 */
+	mic::configuration::Property<long> seed;
+
+	/*!
+	 * Property: flag denoting whether the observation should be updated incrementally when the agent moves by a single cell
+	 * (instead of being copied from scratch).
+	 */
+	mic::configuration::Property<bool> incremental_observation;
+
+	/*!
+	 * Property: flag denoting whether the observations of all positions should be encoded once per episode (POMDP only).
+	 * Used by the environments that are static within an episode (MazeOfDigits, MNISTDigit).
+	 */
+	mic::configuration::Property<bool> observation_cache;
+
 	/// Number of channels.
 	size_t channels;
 
@@ -257,6 +401,54 @@ protected:
 	 */
 	mic::types::TensorXfPtr observation_grid;
 
+	/*!
+	 * Copy of the environment grid surrounded by a border of roi_size/2 cells filled with the padding values of channels.
+	 * Stored with the same layout as the tensors - [channel][y][x].
+	 */
+	std::vector<float> padded_grid;
+
+	/// Width of the border of the padded grid.
+	size_t padding;
+
+	/// Width of the padded grid.
+	size_t padded_width;
+
+	/// Height of the padded grid.
+	size_t padded_height;
+
+	/// Flag denoting that the padded grid is out of sync with the environment grid.
+	bool padded_grid_dirty;
+
+	/// Flag denoting that the observation grid holds the ROI centered in observed_position (so it can be updated incrementally).
+	bool observation_valid;
+
+	/// Center of the ROI held in the observation grid.
+	mic::types::Position2D observed_position;
+
+	/// First channel of the environment held in the observation grid.
+	size_t observed_first_channel;
+
+	/// Number of channels held in the observation grid.
+	size_t observed_channels;
+
+	/// Indices (in the padded grid) of cells changed since the last extraction of the observation.
+	std::vector<size_t> changed_cells;
+
+	/// Observations of all positions of the current episode - [observation_size, width * height].
+	mic::types::MatrixXfPtr cached_observations;
+
+	/// Flag denoting that the observation cache holds the observations of the current episode.
+	bool observation_cache_valid;
+
+	/// Random generator used in generation of the environment.
+	mic::types::Xoshiro256 rng;
+
+	/// Index of the stream of the random generator.
+	size_t rng_stream;
+
+	/// Flag denoting whether the random generator must be (re)seeded before the next use.
+	bool rng_reseed;
+
 };
 
 } /* namespace environments */
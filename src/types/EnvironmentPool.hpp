@@ -0,0 +1,170 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file EnvironmentPool.hpp
+ * \brief Contains declaration (and definition) of a pool of environments pre-generated in a background thread.
+ * \author tkornut
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_TYPES_ENVIRONMENTPOOL_HPP_
+#define SRC_TYPES_ENVIRONMENTPOOL_HPP_
+
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace mic {
+namespace environments {
+
+/*!
+ * \brief Bounded pool of environments (episodes) generated in a background thread.
+ * The generator thread works on its own copy of the prototype environment: it calls initializeEnvironment() and stores deep copies
+ * of the results in a queue, so at the beginning of an episode the application only copies the ready layout instead of generating it.
+ * The environment type must be copy constructible and assignable (deep copy), and its generation must not use the shared RAN_GEN.
+ * \author tkornuta
+ * \tparam EnvironmentType Type of the environment (e.g. Gridworld or MazeOfDigits).
+ */
+template <class EnvironmentType>
+class EnvironmentPool {
+public:
+	/*!
+	 * Constructor. Does not start the generator thread.
+	 * @param prototype_ Environment used as a template for generation (its properties, e.g. type and size, are copied).
+	 * @param capacity_ Maximum number of pre-generated environments.
+	 */
+	EnvironmentPool(const EnvironmentType & prototype_, size_t capacity_) :
+		generator(prototype_), capacity((capacity_ > 0) ? capacity_ : 1), running(false) { }
+
+	/*!
+	 * Destructor - stops the generator thread.
+	 */
+	virtual ~EnvironmentPool() {
+		stop();
+	}
+
+	/*!
+	 * Starts the generator thread.
+	 */
+	void start() {
+		if (running)
+			return;
+		running = true;
+		generator_thread = std::thread(&EnvironmentPool::run, this);
+	}
+
+	/*!
+	 * Stops the generator thread (waits till the current environment is generated).
+	 */
+	void stop() {
+		{
+			std::lock_guard<std::mutex> lock(pool_mutex);
+			running = false;
+		}
+		not_full.notify_all();
+		if (generator_thread.joinable())
+			generator_thread.join();
+	}
+
+	/*!
+	 * Copies the next pre-generated environment into the one passed as argument (waits if the pool is empty).
+	 * If the generator thread is not running the environment is simply (re)initialized in the calling thread.
+	 * @param env_ Environment to be overwritten.
+	 */
+	void acquire(EnvironmentType & env_) {
+		std::shared_ptr<EnvironmentType> next;
+		{
+			std::unique_lock<std::mutex> lock(pool_mutex);
+			not_empty.wait(lock, [this]() { return (!pool.empty()) || (!running); });
+			if (pool.empty()) {
+				lock.unlock();
+				env_.initializeEnvironment();
+				return;
+			}//: if
+			next = pool.front();
+			pool.pop_front();
+		}
+		not_full.notify_one();
+
+		env_ = *next;
+	}
+
+	/*!
+	 * Returns the number of pre-generated environments waiting in the pool.
+	 */
+	size_t size() {
+		std::lock_guard<std::mutex> lock(pool_mutex);
+		return pool.size();
+	}
+
+private:
+	/*!
+	 * Main loop of the generator thread.
+	 */
+	void run() {
+		while (true) {
+			{
+				std::unique_lock<std::mutex> lock(pool_mutex);
+				not_full.wait(lock, [this]() { return (pool.size() < capacity) || (!running); });
+				if (!running)
+					break;
+			}
+
+			// Generate the environment outside of the lock.
+			generator.initializeEnvironment();
+			std::shared_ptr<EnvironmentType> env = std::make_shared<EnvironmentType>(generator);
+
+			{
+				std::lock_guard<std::mutex> lock(pool_mutex);
+				pool.push_back(env);
+			}
+			not_empty.notify_one();
+		}//: while
+		// Wake up the consumers waiting for the environments.
+		not_empty.notify_all();
+	}
+
+	/// Environment used (only) by the generator thread.
+	EnvironmentType generator;
+
+	/// Pre-generated environments.
+	std::deque<std::shared_ptr<EnvironmentType> > pool;
+
+	/// Maximum number of pre-generated environments.
+	size_t capacity;
+
+	/// Flag denoting whether the generator thread is running - guarded by the pool_mutex.
+	bool running;
+
+	/// Mutex guarding the pool.
+	std::mutex pool_mutex;
+
+	/// Condition variable signalled when an environment is added to the pool.
+	std::condition_variable not_empty;
+
+	/// Condition variable signalled when an environment is taken from the pool.
+	std::condition_variable not_full;
+
+	/// The generator thread.
+	std::thread generator_thread;
+};
+
+} /* namespace environments */
+} /* namespace mic */
+
+#endif /* SRC_TYPES_ENVIRONMENTPOOL_HPP_ */
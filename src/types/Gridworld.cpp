@@ -22,6 +22,8 @@
 
 #include <types/Gridworld.hpp>
 
+#include <algorithm>
+
 namespace mic {
 namespace environments {
 
@@ -32,7 +34,9 @@ Gridworld::Gridworld(std::string node_name_) : Environment(node_name_),
 	registerProperty(type);
 
 	channels = (size_t)GridworldChannels::Count;
-
+	agent_position.set(0,0);
+	grid_dirty = true;
+	visit_generation = 0;
 }
 
 Gridworld::Gridworld (const mic::environments::Gridworld & gw_) : Environment(gw_.getNodeName()+"_copy"),
@@ -42,14 +46,13 @@ Gridworld::Gridworld (const mic::environments::Gridworld & gw_) : Environment(gw
 	registerProperty(type);
 	// Not used, but still let's copy it.
 	type = gw_.type;
-	// Copy size.
-	width = gw_.width;
-	height = gw_.height;
-	channels = gw_.channels;
-	// Copy the environment.
-	initial_position = gw_.initial_position;
-	environment_grid = gw_.environment_grid;
-	observation_grid = gw_.observation_grid;
+	// Copy size and (deep copy) the environment.
+	copyEnvironment(gw_);
+	cells = gw_.cells;
+	rewards = gw_.rewards;
+	agent_position = gw_.agent_position;
+	grid_dirty = gw_.grid_dirty;
+	visit_generation = 0;
 }
 
 
@@ -61,14 +64,12 @@ Gridworld::~Gridworld() {
 mic::environments::Gridworld & Gridworld::operator= (const mic::environments::Gridworld & gw_) {
 	// Not used, but still let's copy it.
 	type = gw_.type;
-	// Copy size.
-	width = gw_.width;
-	height = gw_.height;
-	channels = gw_.channels;
-	// Copy the environment.
-	initial_position = gw_.initial_position;
-	environment_grid = gw_.environment_grid;
-	observation_grid = gw_.observation_grid;
+	// Copy size and (deep copy) the environment.
+	copyEnvironment(gw_);
+	cells = gw_.cells;
+	rewards = gw_.rewards;
+	agent_position = gw_.agent_position;
+	grid_dirty = gw_.grid_dirty;
 	// Return pointer to updated instance.
 	return *this;
 }
@@ -119,21 +120,20 @@ void Gridworld::initExemplaryGrid() {
 	height = 4;
 
 	// Set gridworld size.
-	environment_grid->resize({width, height, channels});
-	environment_grid->zeros();
+	resizeGrid();
 
 	// Place the agent.
 	initial_position.set(0,1);
 	moveAgentToPosition(initial_position);
 
 	// Place wall(s).
-	(*environment_grid)({2,2, (size_t)GridworldChannels::Walls}) = 1;
+	placeObject(2, 2, CellWall);
 
 	// Place pit(s).
-	(*environment_grid)({1,1, (size_t)GridworldChannels::Pits}) = -10;
+	placeObject(1, 1, CellPit, -10);
 
 	// Place goal(s).
-	(*environment_grid)({3,3, (size_t)GridworldChannels::Goals}) = 10;
+	placeObject(3, 3, CellGoal, 10);
 }
 
 
@@ -148,8 +148,7 @@ void Gridworld::initClassicCliffGrid() {
 	height = 3;
 
 	// Set gridworld size.
-	environment_grid->resize({width, height, channels});
-	environment_grid->zeros();
+	resizeGrid();
 
 	// Place the agent.
 	initial_position.set(0,1);
@@ -157,10 +156,10 @@ void Gridworld::initClassicCliffGrid() {
 
 	// Place pit(s).
 	for(size_t x=0; x<width; x++)
-		(*environment_grid)({x,2, (size_t)GridworldChannels::Pits}) = -100;
+		placeObject(x, 2, CellPit, -100);
 
 	// Place goal(s).
-	(*environment_grid)({4,1, (size_t)GridworldChannels::Goals}) = 10;
+	placeObject(4, 1, CellGoal, 10);
 }
 
 void Gridworld::initDiscountGrid() {
@@ -176,8 +175,7 @@ void Gridworld::initDiscountGrid() {
 	height = 5;
 
 	// Set gridworld size.
-	(*environment_grid).resize({width, height, channels});
-	(*environment_grid).zeros();
+	resizeGrid();
 
 	// Place the agent.
 	initial_position.set(0,3);
@@ -185,16 +183,16 @@ void Gridworld::initDiscountGrid() {
 
 	// Place pits.
 	for(size_t x=0; x<width; x++)
-		(*environment_grid)({x,4, (size_t)GridworldChannels::Pits}) = -10;
+		placeObject(x, 4, CellPit, -10);
 
 	// Place wall(s).
-	(*environment_grid)({1,1, (size_t)GridworldChannels::Walls}) = 1;
-	(*environment_grid)({1,2, (size_t)GridworldChannels::Walls}) = 1;
-	(*environment_grid)({3,2, (size_t)GridworldChannels::Walls}) = 1;
+	placeObject(1, 1, CellWall);
+	placeObject(1, 2, CellWall);
+	placeObject(3, 2, CellWall);
 
 	// Place goal(s).
-	(*environment_grid)({2,2, (size_t)GridworldChannels::Goals}) = 1;
-	(*environment_grid)({4,2, (size_t)GridworldChannels::Goals}) = 10;
+	placeObject(2, 2, CellGoal, 1);
+	placeObject(4, 2, CellGoal, 10);
 }
 
 
@@ -208,9 +206,8 @@ void Gridworld::initBridgeGrid() {
 	width = 7;
 	height = 3;
 
-	// Set environment_grid size.
-	environment_grid->resize({width, height, channels});
-	environment_grid->zeros();
+	// Set grid size.
+	resizeGrid();
 
 	// Place the agent.
 	initial_position.set(1,1);
@@ -218,19 +215,19 @@ void Gridworld::initBridgeGrid() {
 
 	// Place pits.
 	for(size_t x=1; x<width-1; x++) {
-		(*environment_grid)({x,0, (size_t)GridworldChannels::Pits}) = -100;
-		(*environment_grid)({x,2, (size_t)GridworldChannels::Pits}) = -100;
+		placeObject(x, 0, CellPit, -100);
+		placeObject(x, 2, CellPit, -100);
 	}//: for
 
 	// Place wall(s).
-	(*environment_grid)({0,0, (size_t)GridworldChannels::Walls}) = 1;
-	(*environment_grid)({0,2, (size_t)GridworldChannels::Walls}) = 1;
-	(*environment_grid)({6,0, (size_t)GridworldChannels::Walls}) = 1;
-	(*environment_grid)({6,2, (size_t)GridworldChannels::Walls}) = 1;
+	placeObject(0, 0, CellWall);
+	placeObject(0, 2, CellWall);
+	placeObject(6, 0, CellWall);
+	placeObject(6, 2, CellWall);
 
 	// Place goal(s).
-	(*environment_grid)({0,1, (size_t)GridworldChannels::Goals}) = 1;
-	(*environment_grid)({6,1, (size_t)GridworldChannels::Goals}) = 10;
+	placeObject(0, 1, CellGoal, 1);
+	placeObject(6, 1, CellGoal, 10);
 }
 
 
@@ -244,22 +241,21 @@ void Gridworld::initBookGrid() {
 	width = 4;
 	height = 3;
 
-	// Set environment_grid size.
-	environment_grid->resize({width, height, channels});
-	environment_grid->zeros();
+	// Set grid size.
+	resizeGrid();
 
 	// Place the agent.
 	initial_position.set(0,2);
 	moveAgentToPosition(initial_position);
 
 	// Place wall(s).
-	(*environment_grid)({1,1, (size_t)GridworldChannels::Walls}) = 1;
+	placeObject(1, 1, CellWall);
 
 	// Place pit(s).
-	(*environment_grid)({3,1, (size_t)GridworldChannels::Pits}) = -1;
+	placeObject(3, 1, CellPit, -1);
 
 	// Place goal(s).
-	(*environment_grid)({3,0, (size_t)GridworldChannels::Goals}) = 1;
+	placeObject(3, 0, CellGoal, 1);
 }
 
 
@@ -275,24 +271,23 @@ void Gridworld::initMazeGrid() {
 	width = 4;
 	height = 5;
 
-	// Set environment_grid size.
-	environment_grid->resize({width, height, channels});
-	environment_grid->zeros();
+	// Set grid size.
+	resizeGrid();
 
 	// Place the agent.
 	initial_position.set(0,4);
 	moveAgentToPosition(initial_position);
 
 	// Place wall(s).
-	(*environment_grid)({0,1, (size_t)GridworldChannels::Walls}) = 1;
-	(*environment_grid)({1,1, (size_t)GridworldChannels::Walls}) = 1;
-	(*environment_grid)({1,2, (size_t)GridworldChannels::Walls}) = 1;
-	(*environment_grid)({1,3, (size_t)GridworldChannels::Walls}) = 1;
-	(*environment_grid)({2,3, (size_t)GridworldChannels::Walls}) = 1;
-	(*environment_grid)({3,1, (size_t)GridworldChannels::Walls}) = 1;
+	placeObject(0, 1, CellWall);
+	placeObject(1, 1, CellWall);
+	placeObject(1, 2, CellWall);
+	placeObject(1, 3, CellWall);
+	placeObject(2, 3, CellWall);
+	placeObject(3, 1, CellWall);
 
 	// Place goal(s).
-	(*environment_grid)({3,0, (size_t)GridworldChannels::Goals}) = 1;
+	placeObject(3, 0, CellGoal, 1);
 }
 
 
@@ -309,22 +304,21 @@ void Gridworld::initExemplaryDQLGrid() {
 	width = 4;
 	height = 4;
 
-	// Set environment_grid size.
-	environment_grid->resize({width, height, channels});
-	environment_grid->zeros();
+	// Set grid size.
+	resizeGrid();
 
 	// Place the agent.
 	initial_position.set(0,3);
 	moveAgentToPosition(initial_position);
 
 	// Place wall(s).
-	(*environment_grid)({1,2, (size_t)GridworldChannels::Walls}) = 1;
+	placeObject(1, 2, CellWall);
 
 	// Place pit(s).
-	(*environment_grid)({2,2, (size_t)GridworldChannels::Pits}) = -10;
+	placeObject(2, 2, CellPit, -10);
 
 	// Place goal(s).
-	(*environment_grid)({2,1, (size_t)GridworldChannels::Goals}) = 10;
+	placeObject(2, 1, CellGoal, 10);
 }
 
 void Gridworld::initModifiedDQLGrid() {
@@ -340,22 +334,21 @@ void Gridworld::initModifiedDQLGrid() {
 	width = 4;
 	height = 4;
 
-	// Set environment_grid size.
-	environment_grid->resize({width, height, channels});
-	environment_grid->zeros();
+	// Set grid size.
+	resizeGrid();
 
 	// Place the agent.
 	initial_position.set(0,3);
 	moveAgentToPosition(initial_position);
 
 	// Place wall(s).
-	(*environment_grid)({1,1, (size_t)GridworldChannels::Walls}) = 1;
+	placeObject(1, 1, CellWall);
 
 	// Place pit(s).
-	(*environment_grid)({2,2, (size_t)GridworldChannels::Pits}) = -10;
+	placeObject(2, 2, CellPit, -10);
 
 	// Place goal(s).
-	(*environment_grid)({2,1, (size_t)GridworldChannels::Goals}) = 10;
+	placeObject(2, 1, CellGoal, 10);
 }
 
 
@@ -370,19 +363,18 @@ void Gridworld::initDebug2x2Grid() {
 	width = 2;
 	height = 2;
 
-	// Set environment_grid size.
-	environment_grid->resize({width, height, channels});
-	environment_grid->zeros();
+	// Set grid size.
+	resizeGrid();
 
 	// Place the agent.
 	initial_position.set(0,0);
 	moveAgentToPosition(initial_position);
 
 	// Place pit(s).
-	(*environment_grid)({1,0, (size_t)GridworldChannels::Pits}) = -10;
+	placeObject(1, 0, CellPit, -10);
 
 	// Place goal(s).
-	(*environment_grid)({0,1, (size_t)GridworldChannels::Goals}) = 10;
+	placeObject(0, 1, CellGoal, 10);
 }
 
 
@@ -402,24 +394,23 @@ void Gridworld::initDebug3x3Grid() {
 	width = 3;
 	height = 3;
 
-	// Set environment_grid size.
-	environment_grid->resize({width, height, channels});
-	environment_grid->zeros();
+	// Set grid size.
+	resizeGrid();
 
 	// Place the agent.
 	initial_position.set(1,1);
 	moveAgentToPosition(initial_position);
 
 	// Place wall(s).
-	(*environment_grid)({1,2, (size_t)GridworldChannels::Walls}) = 1;
+	placeObject(1, 2, CellWall);
 
 	// Place pit(s).
-	(*environment_grid)({0,1, (size_t)GridworldChannels::Pits}) = -10;
-	(*environment_grid)({1,0, (size_t)GridworldChannels::Pits}) = -10;
-	(*environment_grid)({2,1, (size_t)GridworldChannels::Pits}) = -10;
+	placeObject(0, 1, CellPit, -10);
+	placeObject(1, 0, CellPit, -10);
+	placeObject(2, 1, CellPit, -10);
 
 	// Place goal(s).
-	(*environment_grid)({1,2, (size_t)GridworldChannels::Goals}) = 10;
+	placeObject(1, 2, CellGoal, 10);
 
 }
 
@@ -427,46 +418,41 @@ void Gridworld::initDebug3x3Grid() {
 void Gridworld::initSimpleRandomGrid() {
 	LOG(LINFO) << "Generating simple " << width << "x" << height<< " random grid";
 
-	// Set environment_grid size.
-	environment_grid->resize({width, height, channels});
-	environment_grid->zeros();
+	// Set grid size.
+	resizeGrid();
 
 	// Place the agent.
-	mic::types::Position2D agent(0, width-1, 0, height-1);
+	mic::types::Position2D agent = randomPosition(0, width-1, 0, height-1);
 	initial_position = agent;
 	moveAgentToPosition(initial_position);
 
-	// Initialize random device and generator.
-	std::random_device rd;
-	std::mt19937_64 rng_mt19937_64(rd());
-
 	// Place wall.
 	while (1){
 		// Random position.
-		mic::types::Position2D wall(0, width-1, 0, height-1);
+		mic::types::Position2D wall = randomPosition(0, width-1, 0, height-1);
 
 		// Validate pose.
-		if ((*environment_grid)({(size_t)wall.x, (size_t)wall.y, (size_t)GridworldChannels::Agent}) != 0)
+		if (hasObject(wall.x, wall.y, CellAgent))
 			continue;
 
 		// Add wall...
-		(*environment_grid)({(size_t)wall.x, (size_t)wall.y, (size_t)GridworldChannels::Walls}) = 1;
+		placeObject(wall.x, wall.y, CellWall);
 		break;
 	}
 
 	// Place pit.
 	while(1){
 		// Random position.
-		mic::types::Position2D pit(0, width-1, 0, height-1);
+		mic::types::Position2D pit = randomPosition(0, width-1, 0, height-1);
 
 		// Validate pose.
-		if ((*environment_grid)({(size_t)pit.x, (size_t)pit.y, (size_t)GridworldChannels::Agent}) != 0)
+		if (hasObject(pit.x, pit.y, CellAgent))
 			continue;
-		if ((*environment_grid)({(size_t)pit.x, (size_t)pit.y, (size_t)GridworldChannels::Walls}) != 0)
+		if (hasObject(pit.x, pit.y, CellWall))
 			continue;
 
 		// Add pit...
-		(*environment_grid)({(size_t)pit.x, (size_t)pit.y, (size_t)GridworldChannels::Pits}) = -10;
+		placeObject(pit.x, pit.y, CellPit, -10);
 
 		break;
 	}//: while
@@ -475,14 +461,14 @@ void Gridworld::initSimpleRandomGrid() {
 	// Place goal.
 	while(1) {
 		// Random position.
-		mic::types::Position2D goal(0, width-1, 0, height-1);
+		mic::types::Position2D goal = randomPosition(0, width-1, 0, height-1);
 
 		// Validate pose.
-		if ((*environment_grid)({(size_t)goal.x, (size_t)goal.y, (size_t)GridworldChannels::Agent}) != 0)
+		if (hasObject(goal.x, goal.y, CellAgent))
 			continue;
-		if ((*environment_grid)({(size_t)goal.x, (size_t)goal.y, (size_t)GridworldChannels::Walls}) != 0)
+		if (hasObject(goal.x, goal.y, CellWall))
 			continue;
-		if ((*environment_grid)({(size_t)goal.x, (size_t)goal.y, (size_t)GridworldChannels::Pits}) != 0)
+		if (hasObject(goal.x, goal.y, CellPit))
 			continue;
 
 		// ... but additionally check the goal surroundings - there must be at least one way out, and not going through the pit!
@@ -491,7 +477,7 @@ void Gridworld::initSimpleRandomGrid() {
 			mic::types::NESWAction action(a);
 			mic::types::Position2D way_to_goal = goal + action;
 			if ((isStateAllowed(way_to_goal)) &&
-					((*environment_grid)({(size_t)way_to_goal.x, (size_t)way_to_goal.y, (size_t)GridworldChannels::Pits}) == 0)) {
+					(!hasObject(way_to_goal.x, way_to_goal.y, CellPit))) {
 				reachable = true;
 				break;
 			}//: if
@@ -500,39 +486,71 @@ void Gridworld::initSimpleRandomGrid() {
 			continue;
 
 		// Ok, add the goal.
-		(*environment_grid)({(size_t)goal.x, (size_t)goal.y, (size_t)GridworldChannels::Goals}) = 10;
+		placeObject(goal.x, goal.y, CellGoal, 10);
 		break;
 	}//: while
 
 }
 
-bool Gridworld::isGridTraversible(long x_, long y_, mic::types::Matrix<bool> & visited_) {
-	// If not allowed...
-	if (!isStateAllowed(x_, y_))
-		return false;
-	// .. or is a pit...
-	if ((*environment_grid)({(size_t)x_, (size_t)y_, (size_t)GridworldChannels::Pits}) < 0)
-		return false;
-	// ... or wasa already visited.
-	if (visited_(y_,x_))
-		return false;
-	// Ok found the goal!
-	if ((*environment_grid)({(size_t)x_, (size_t)y_, (size_t)GridworldChannels::Goals}) > 0)
-		return true;
-	// Ok, new state.
-	visited_(y_,x_) = true;
+long Gridworld::distanceToGoal(long x_, long y_) {
+	// The start state must be allowed and cannot be a pit.
+	if ((!isStateAllowed(x_, y_)) || hasObject(x_, y_, CellPit))
+		return -1;
+
+	// Reuse the buffers - they are (re)allocated only when the size of the grid changes.
+	size_t number_of_cells = width * height;
+	if (visit_stamps.size() != number_of_cells) {
+		visit_stamps.assign(number_of_cells, 0);
+		bfs_distances.resize(number_of_cells);
+		bfs_queue.resize(number_of_cells);
+		visit_generation = 0;
+	}//: if
+	// Start a new generation - markers from the previous searches become outdated, so there is no need to clear them.
+	if (++visit_generation == 0) {
+		std::fill(visit_stamps.begin(), visit_stamps.end(), 0);
+		visit_generation = 1;
+	}//: if
+
+	// Iterative breadth-first search - every cell is queued at most once.
+	size_t head = 0, tail = 0;
+	uint32_t start = cellIndex(x_, y_);
+	visit_stamps[start] = visit_generation;
+	bfs_distances[start] = 0;
+	bfs_queue[tail++] = start;
+
+	while (head < tail) {
+		uint32_t index = bfs_queue[head++];
+		// Ok found the goal!
+		if (cells[index] & CellGoal)
+			return bfs_distances[index];
+
+		long x = index % width;
+		long y = index / width;
+		// Check NESW.
+		const long nx[4] = {x, x+1, x, x-1};
+		const long ny[4] = {y-1, y, y+1, y};
+		for (size_t a=0; a<4; a++){
+			if ((nx[a] < 0) || (nx[a] >= (long)width) || (ny[a] < 0) || (ny[a] >= (long)height))
+				continue;
+			uint32_t next = cellIndex(nx[a], ny[a]);
+			// Skip walls, pits and already visited states.
+			if ((cells[next] & (CellWall | CellPit)) || (visit_stamps[next] == visit_generation))
+				continue;
+			visit_stamps[next] = visit_generation;
+			bfs_distances[next] = bfs_distances[index] + 1;
+			bfs_queue[tail++] = next;
+		}//: for
+	}//: while
 
-	// Recursive check NESW.
-	if (isGridTraversible(x_, y_-1, visited_))
-		return true;
-	if (isGridTraversible(x_+1, y_, visited_))
-		return true;
-	if (isGridTraversible(x_, y_+1, visited_))
-		return true;
-	if (isGridTraversible(x_-1, y_, visited_))
-		return true;
-	// Sorry, no luck in her.
-	return false;
+	// The goal is not reachable.
+	return -1;
+}
+
+
+unsigned int Gridworld::optimalPathLength() {
+	mic::types::Position2D start = getAgentPosition();
+	long distance = distanceToGoal(start.x, start.y);
+	return (distance > 0) ? distance : 0;
 }
 
 
@@ -540,32 +558,30 @@ bool Gridworld::isGridTraversible(long x_, long y_, mic::types::Matrix<bool> & v
 void Gridworld::initHardRandomGrid() {
 	LOG(LINFO) << "Generating hard " << width << "x" << height<< " random grid";
 
-	// Set environment_grid size.
-	environment_grid->resize({width, height, channels});
-	environment_grid->zeros();
+	// Set grid size.
+	resizeGrid();
 
 	// Place the agent.
-	mic::types::Position2D agent(0, width-1, 0, height-1);
+	mic::types::Position2D agent = randomPosition(0, width-1, 0, height-1);
 	initial_position = agent;
 	moveAgentToPosition(initial_position);
 
 	// Place goal.
 	while(1) {
 		// Random position.
-		mic::types::Position2D goal(0, width-1, 0, height-1);
+		mic::types::Position2D goal = randomPosition(0, width-1, 0, height-1);
 
 		// Validate pose.
-		if ((*environment_grid)({(size_t)goal.x, (size_t)goal.y, (size_t)GridworldChannels::Agent}) != 0)
+		if (hasObject(goal.x, goal.y, CellAgent))
 			continue;
 
 		// Ok, add the goal.
-		(*environment_grid)({(size_t)goal.x, (size_t)goal.y, (size_t)GridworldChannels::Goals}) = 10;
+		placeObject(goal.x, goal.y, CellGoal, 10);
 		break;
 	}//: while
 
-	// Initialize random device and generator.
-	std::random_device rd;
-	std::mt19937_64 rng_mt19937_64(rd());
+	// Get the (seedable) random generator of the environment.
+	mic::types::Xoshiro256 & rng_gen = getRandomGenerator();
 
 
 	// Initialize uniform integer distribution.
@@ -573,33 +589,29 @@ void Gridworld::initHardRandomGrid() {
 	std::uniform_int_distribution<size_t> obstacle_dist(0, max_obstacles);
 
 	// Calculate number of walls.
-	size_t number_of_walls = obstacle_dist(rng_mt19937_64);
-
-	// Matrix informing us thwther we already visited the state or not.
-	mic::types::Matrix<bool> visited (height, width);
+	size_t number_of_walls = obstacle_dist(rng_gen);
 
 	// Place wall(s).
 	for (size_t i=0; i<number_of_walls; i++) {
 		while (1){
 			// Random position.
-			mic::types::Position2D wall(0, width-1, 0, height-1);
+			mic::types::Position2D wall = randomPosition(0, width-1, 0, height-1);
 
 			// Validate pose.
-			if ((*environment_grid)({(size_t)wall.x, (size_t)wall.y, (size_t)GridworldChannels::Agent}) != 0)
+			if (hasObject(wall.x, wall.y, CellAgent))
 				continue;
-			if ((*environment_grid)({(size_t)wall.x, (size_t)wall.y, (size_t)GridworldChannels::Goals}) != 0)
+			if (hasObject(wall.x, wall.y, CellGoal))
 				continue;
-			if ((*environment_grid)({(size_t)wall.x, (size_t)wall.y, (size_t)GridworldChannels::Walls}) != 0)
+			if (hasObject(wall.x, wall.y, CellWall))
 				continue;
 
 			// Add wall...
-			(*environment_grid)({(size_t)wall.x, (size_t)wall.y, (size_t)GridworldChannels::Walls}) = 1;
+			placeObject(wall.x, wall.y, CellWall);
 
 			// ... but additionally whether the path from agent to the goal is traversable!
-			visited.setZero();
-			if (!isGridTraversible(agent.x, agent.y, visited)) {
+			if (distanceToGoal(agent.x, agent.y) < 0) {
 				// Sorry, we must remove this wall...
-				(*environment_grid)({(size_t)wall.x, (size_t)wall.y, (size_t)GridworldChannels::Walls}) = 0;
+				removeObject(wall.x, wall.y, CellWall);
 				// .. and try once again.
 				continue;
 			}//: if
@@ -610,32 +622,31 @@ void Gridworld::initHardRandomGrid() {
 
 
 	// Calculate number of pits.
-	size_t number_of_pits = obstacle_dist(rng_mt19937_64);
+	size_t number_of_pits = obstacle_dist(rng_gen);
 
 	// Place pit(s).
 	for (size_t i=0; i<number_of_pits; i++) {
 		while(1){
 			// Random position.
-			mic::types::Position2D pit(0, width-1, 0, height-1);
+			mic::types::Position2D pit = randomPosition(0, width-1, 0, height-1);
 
 			// Validate pose.
-			if ((*environment_grid)({(size_t)pit.x, (size_t)pit.y, (size_t)GridworldChannels::Agent}) != 0)
+			if (hasObject(pit.x, pit.y, CellAgent))
 				continue;
-			if ((*environment_grid)({(size_t)pit.x, (size_t)pit.y, (size_t)GridworldChannels::Goals}) != 0)
+			if (hasObject(pit.x, pit.y, CellGoal))
 				continue;
-			if ((*environment_grid)({(size_t)pit.x, (size_t)pit.y, (size_t)GridworldChannels::Pits}) != 0)
+			if (hasObject(pit.x, pit.y, CellPit))
 				continue;
-			if ((*environment_grid)({(size_t)pit.x, (size_t)pit.y, (size_t)GridworldChannels::Walls}) != 0)
+			if (hasObject(pit.x, pit.y, CellWall))
 				continue;
 
 			// Add pit...
-			(*environment_grid)({(size_t)pit.x, (size_t)pit.y, (size_t)GridworldChannels::Pits}) = -10;
+			placeObject(pit.x, pit.y, CellPit, -10);
 
 			// ... but additionally whether the path from agent to the goal is traversable!
-			visited.setZero();
-			if (!isGridTraversible(agent.x, agent.y, visited)) {
+			if (distanceToGoal(agent.x, agent.y) < 0) {
 				// Sorry, we must remove this pit...
-				(*environment_grid)({(size_t)pit.x, (size_t)pit.y, (size_t)GridworldChannels::Pits}) = 0;
+				removeObject(pit.x, pit.y, CellPit);
 				// .. and try once again.
 				continue;
 			}//: if
@@ -687,7 +698,7 @@ std::string Gridworld::gridToString(mic::types::TensorXfPtr grid_) {
 }
 
 std::string Gridworld::environmentToString() {
-	return gridToString(environment_grid);
+	return gridToString(getEnvironment());
 }
 
 std::string Gridworld::observationToString() {
@@ -697,10 +708,12 @@ std::string Gridworld::observationToString() {
 		return gridToString(obs);
 	}
 	else
-		return gridToString(environment_grid);
+		return gridToString(getEnvironment());
 }
 
 mic::types::MatrixXfPtr Gridworld::encodeEnvironment() {
+	// Make sure the tensor is up to date.
+	materializeGrid();
 	// Temporarily reshape the environment_grid.
 	environment_grid->conservativeResize({1, width * height * channels});
 	// Create a matrix pointer and copy data from grid into the matrix.
@@ -736,28 +749,8 @@ mic::types::MatrixXfPtr Gridworld::encodeObservation() {
 
 mic::types::TensorXfPtr Gridworld::getObservation() {
 	LOG(LDEBUG) << "getObservation()";
-	// Reset.
-	observation_grid->zeros();
-
-	size_t delta = (roi_size-1)/2;
-	mic::types::Position2D p = getAgentPosition();
-
-	// Copy data.
-	for (long oy=0, ey=(p.y-delta); oy< (long)roi_size; oy++, ey++){
-		for (long ox=0, ex=(p.x-delta); ox< (long)roi_size; ox++, ex++) {
-			// Check grid boundaries.
-			if ((ex < 0) || (ex >= (long)width) || (ey < 0) || (ey >= (long)height)){
-				// Place the wall only
-				(*observation_grid)({(size_t)ox, (size_t)oy, (size_t)GridworldChannels::Walls}) = 1;
-				continue;
-			}//: if
-			// Else : copy data for all channels.
-			(*observation_grid)({(size_t)ox,(size_t)oy, (size_t)GridworldChannels::Goals}) = (*environment_grid)({(size_t)ex,(size_t)ey, (size_t)GridworldChannels::Goals});
-			(*observation_grid)({(size_t)ox,(size_t)oy, (size_t)GridworldChannels::Pits}) = (*environment_grid)({(size_t)ex,(size_t)ey, (size_t)GridworldChannels::Pits});
-			(*observation_grid)({(size_t)ox,(size_t)oy, (size_t)GridworldChannels::Walls}) = (*environment_grid)({(size_t)ex,(size_t)ey, (size_t)GridworldChannels::Walls});
-			(*observation_grid)({(size_t)ox,(size_t)oy, (size_t)GridworldChannels::Agent}) = (*environment_grid)({(size_t)ex,(size_t)ey, (size_t)GridworldChannels::Agent});
-		}//: for x
-	}//: for y
+	// Copy the ROI (all channels) - cells outside of the gridworld are walls.
+	extractObservation(agent_position, 0, channels);
 
 	//LOG(LDEBUG) << std::endl << gridToString(observation_grid);
 
@@ -765,21 +758,73 @@ mic::types::TensorXfPtr Gridworld::getObservation() {
 }
 
 
-mic::types::MatrixXfPtr Gridworld::encodeAgentGrid() {
-	// DEBUG - copy only agent pose data, avoid goals etc.
-	mic::types::MatrixXfPtr encoded_grid (new mic::types::MatrixXf(height, width));
-	encoded_grid->setZero();
+mic::types::TensorXfPtr & Gridworld::getEnvironment() {
+	materializeGrid();
+	return environment_grid;
+}
+
+
+void Gridworld::resizeGrid() {
+	cells.assign(width * height, CellEmpty);
+	rewards.assign(width * height, 0.0f);
+	agent_position.set(0,0);
+	grid_dirty = true;
+	invalidatePaddedGrid();
+}
 
+
+void Gridworld::placeObject(long x_, long y_, GridworldCellFlags flag_, float reward_) {
+	size_t index = cellIndex(x_, y_);
+	cells[index] |= flag_;
+	if ((flag_ == CellPit) || (flag_ == CellGoal))
+		rewards[index] = reward_;
+	grid_dirty = true;
+	invalidatePaddedGrid();
+}
+
+
+void Gridworld::removeObject(long x_, long y_, GridworldCellFlags flag_) {
+	size_t index = cellIndex(x_, y_);
+	cells[index] &= ~flag_;
+	if ((flag_ == CellPit) || (flag_ == CellGoal))
+		rewards[index] = 0.0f;
+	grid_dirty = true;
+	invalidatePaddedGrid();
+}
+
+
+void Gridworld::materializeGrid() {
+	if (!grid_dirty)
+		return;
+
+	environment_grid->resize({width, height, channels});
+	environment_grid->zeros();
 	for (size_t y=0; y<height; y++){
 		for (size_t x=0; x<width; x++) {
-			// Check object occupancy.
-			if ((*environment_grid)({x,y, (size_t)GridworldChannels::Agent}) != 0) {
-				// Set one.
-				(*encoded_grid)(y,x) = 1;
-				break;
-			}
+			size_t index = cellIndex(x, y);
+			uint8_t cell = cells[index];
+			if (cell & CellGoal)
+				(*environment_grid)({x,y, (size_t)GridworldChannels::Goals}) = rewards[index];
+			if (cell & CellPit)
+				(*environment_grid)({x,y, (size_t)GridworldChannels::Pits}) = rewards[index];
+			if (cell & CellWall)
+				(*environment_grid)({x,y, (size_t)GridworldChannels::Walls}) = 1;
+			if (cell & CellAgent)
+				(*environment_grid)({x,y, (size_t)GridworldChannels::Agent}) = 1;
 		}//: for x
 	}//: for y
+
+	grid_dirty = false;
+}
+
+
+mic::types::MatrixXfPtr Gridworld::encodeAgentGrid() {
+	// DEBUG - copy only agent pose data, avoid goals etc.
+	mic::types::MatrixXfPtr encoded_grid (new mic::types::MatrixXf(height, width));
+	encoded_grid->setZero();
+
+	// Set one.
+	(*encoded_grid)(agent_position.y, agent_position.x) = 1;
 	encoded_grid->resize(height*width, 1);
 
 	// Return the matrix pointer.
@@ -788,18 +833,7 @@ mic::types::MatrixXfPtr Gridworld::encodeAgentGrid() {
 
 
 mic::types::Position2D Gridworld::getAgentPosition() {
-	mic::types::Position2D position;
-	for (size_t y=0; y<height; y++){
-		for (size_t x=0; x<width; x++) {
-			if ((*environment_grid)({x,y, (size_t)GridworldChannels::Agent}) == 1) {
-				position.x = x;
-				position.y = y;
-				return position;
-			}// if
-		}//: for x
-	}//: for y
-	// Remove warnings...
-	return position;
+	return agent_position;
 }
 
 bool Gridworld::moveAgentToPosition(mic::types::Position2D pos_) {
@@ -810,24 +844,27 @@ bool Gridworld::moveAgentToPosition(mic::types::Position2D pos_) {
 		return false;
 
 	// Clear old.
-	mic::types::Position2D old = getAgentPosition();
-	(*environment_grid)({(size_t)old.x, (size_t)old.y, (size_t)GridworldChannels::Agent}) = 0;
+	cells[cellIndex(agent_position.x, agent_position.y)] &= ~CellAgent;
 	// Set new.
-	(*environment_grid)({(size_t)pos_.x, (size_t)pos_.y, (size_t)GridworldChannels::Agent}) = 1;
+	cells[cellIndex(pos_.x, pos_.y)] |= CellAgent;
 
+	// Update the tensor (only if it is in sync, otherwise it will be materialized when required).
+	if (!grid_dirty) {
+		(*environment_grid)({(size_t)agent_position.x, (size_t)agent_position.y, (size_t)GridworldChannels::Agent}) = 0;
+		(*environment_grid)({(size_t)pos_.x, (size_t)pos_.y, (size_t)GridworldChannels::Agent}) = 1;
+	}//: if
+	setPaddedCell(agent_position.x, agent_position.y, (size_t)GridworldChannels::Agent, 0);
+	setPaddedCell(pos_.x, pos_.y, (size_t)GridworldChannels::Agent, 1);
+
+	agent_position = pos_;
 	return true;
 }
 
 
 
 float Gridworld::getStateReward(mic::types::Position2D pos_) {
-	// Check reward - goal or pit.
-    if ((*environment_grid)({(size_t)pos_.x, (size_t)pos_.y, (size_t)GridworldChannels::Pits}) != 0)
-        return (*environment_grid)({(size_t)pos_.x, (size_t)pos_.y, (size_t)GridworldChannels::Pits});
-    else if ((*environment_grid)({(size_t)pos_.x, (size_t)pos_.y, (size_t)GridworldChannels::Goals}) != 0)
-		return (*environment_grid)({(size_t)pos_.x, (size_t)pos_.y, (size_t)GridworldChannels::Goals});
-	else
-        return 0;
+	// Reward is non-zero only for goals and pits.
+	return rewards[cellIndex(pos_.x, pos_.y)];
 }
 
 
@@ -839,7 +876,7 @@ bool Gridworld::isStateAllowed(mic::types::Position2D pos_) {
 			return false;
 
 	// Check walls!
-	if ((*environment_grid)({(size_t)pos_.x, (size_t)pos_.y, (size_t)GridworldChannels::Walls}) != 0)
+	if (hasObject(pos_.x, pos_.y, CellWall))
 		return false;
 
 	return true;
@@ -854,13 +891,7 @@ bool Gridworld::isStateTerminal(mic::types::Position2D pos_) {
 			return false;
 
 	// Check reward - goal or pit.
-    if ((*environment_grid)({(size_t)pos_.x, (size_t)pos_.y, (size_t)GridworldChannels::Pits}) != 0)
-        return true;
-    else if ((*environment_grid)({(size_t)pos_.x, (size_t)pos_.y, (size_t)GridworldChannels::Goals}) != 0)
-        return true;
-    else
-
-        return false;
+	return hasObject(pos_.x, pos_.y, CellPit | CellGoal);
 }
 
 
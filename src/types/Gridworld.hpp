@@ -25,6 +25,9 @@
 
 #include <types/Environment.hpp>
 
+#include <vector>
+#include <cstdint>
+
 
 namespace mic {
 namespace environments {
@@ -43,8 +46,25 @@ enum class GridworldChannels : std::size_t
 };
 
 
+/*!
+ * \brief Flags describing the content of a single gridworld cell (compact representation).
+ * \author tkornuta
+ */
+enum GridworldCellFlags : uint8_t
+{
+	CellEmpty = 0, ///< Empty cell
+	CellGoal = 1 << 0, ///< Cell contains a goal
+	CellPit = 1 << 1, ///< Cell contains a pit
+	CellWall = 1 << 2, ///< Cell contains a wall
+	CellAgent = 1 << 3 ///< Cell contains the agent
+};
+
+
 /*!
  * \brief Class emulating the gridworld environment.
+ * The gridworld is internally stored in a compact form - a single byte of flags (wall, pit, goal, agent) per cell
+ * plus a parallel array of rewards, so the state queries (allowed, terminal, reward) are single loads.
+ * The float tensor (environment_grid) is materialized only when it is required (encoding, visualization).
  * \author tkornuta
  */
 class Gridworld : public mic::environments::Environment {
@@ -56,7 +76,7 @@ public:
 	Gridworld(std::string node_name_ = "gridworld");
 
 	/*!
-	 * Copying constructor.
+	 * Copying constructor. Creates a deep copy of the environment state.
 	 * @param gw_ Gridworld object to be cloned.
 	 */
 	Gridworld (const mic::environments::Gridworld & gw_);
@@ -192,12 +212,20 @@ public:
 	void initHardRandomGrid();
 
 	/*!
-	 * A recursive method for checking whether the grid is traversable (i.e. there is a path from agent to goal).
-	 * @param x_ Current x coordinate to check.
-	 * @param y_ Current x coordinate to check.
-	 * @param visited_ Matrix with visited states.
+	 * Calculates the length of the shortest path from the given position to the closest goal (avoiding walls and pits).
+	 * Iterative breadth-first search reusing preallocated buffers, with visited markers stamped with the search generation
+	 * (so they do not have to be cleared between the searches).
+	 * @param x_ X coordinate of the start.
+	 * @param y_ Y coordinate of the start.
+	 * @return Length of the path, -1 if no goal is reachable.
+	 */
+	long distanceToGoal(long x_, long y_);
+
+	/*!
+	 * Calculates the length of the shortest path from the agent position to the closest goal (avoiding walls and pits).
+	 * @return Length of the path, 0 if no goal is reachable.
 	 */
-	bool isGridTraversible(long x_, long y_, mic::types::Matrix<bool> & visited_);
+	unsigned int optimalPathLength();
 
 	/*!
 	 * Returns the tensor being the observation.
@@ -233,6 +261,12 @@ public:
 	/// Encode the current state of the reduced grid (only the agent position) as a matrix of size [1, width * height]
 	virtual mic::types::MatrixXfPtr encodeAgentGrid();
 
+	/*!
+	 * Returns the tensor storing the environment - materializes it from the compact representation if required.
+	 * @return Tensor storing the environment.
+	 */
+	virtual mic::types::TensorXfPtr & getEnvironment();
+
 	/*!
 	 * Calculates the agent position.
 	 * @return Agent position.
@@ -300,6 +334,81 @@ protected:
 	 */
 	std::string gridToString(mic::types::TensorXfPtr grid_);
 
+	/*!
+	 * Returns the value of the given channel outside of the gridworld - the gridworld is surrounded by walls.
+	 * @param channel_ Index of the channel.
+	 * @return One for the walls channel, zero otherwise.
+	 */
+	virtual float getPaddingValue(size_t channel_) { return (channel_ == (size_t)GridworldChannels::Walls) ? 1.0f : 0.0f; }
+
+	/*!
+	 * Returns the index of the cell in the compact representation.
+	 * @param x_ X coordinate.
+	 * @param y_ Y coordinate.
+	 * @return Index of the cell.
+	 */
+	inline size_t cellIndex(long x_, long y_) { return (size_t)y_ * width + (size_t)x_; }
+
+	/*!
+	 * Checks whether the cell contains given object(s).
+	 * @param x_ X coordinate.
+	 * @param y_ Y coordinate.
+	 * @param flags_ Flag(s) to be checked.
+	 * @return True if any of the objects is present in the cell.
+	 */
+	inline bool hasObject(long x_, long y_, uint8_t flags_) { return (cells[cellIndex(x_, y_)] & flags_) != 0; }
+
+	/*!
+	 * Resizes the grid to the current (width x height) and clears all cells.
+	 */
+	void resizeGrid();
+
+	/*!
+	 * Places the object in the cell.
+	 * @param x_ X coordinate.
+	 * @param y_ Y coordinate.
+	 * @param flag_ Object (wall, pit or goal).
+	 * @param reward_ Reward associated with the cell (pits and goals).
+	 */
+	void placeObject(long x_, long y_, GridworldCellFlags flag_, float reward_ = 0);
+
+	/*!
+	 * Removes the object from the cell.
+	 * @param x_ X coordinate.
+	 * @param y_ Y coordinate.
+	 * @param flag_ Object (wall, pit or goal).
+	 */
+	void removeObject(long x_, long y_, GridworldCellFlags flag_);
+
+	/*!
+	 * Fills the float tensor (environment_grid) with the content of the compact representation.
+	 */
+	void materializeGrid();
+
+	/// Compact representation of the grid - flags of objects in every cell (row-major, y * width + x).
+	std::vector<uint8_t> cells;
+
+	/// Rewards associated with cells (non-zero for pits and goals).
+	std::vector<float> rewards;
+
+	/// Current position of the agent.
+	mic::types::Position2D agent_position;
+
+	/// Flag denoting that the float tensor is out of sync with the compact representation.
+	bool grid_dirty;
+
+	/// Generation of the current search - cells with visit stamp equal to it were already visited.
+	uint32_t visit_generation;
+
+	/// Visit stamps of cells (used by the breadth-first search).
+	std::vector<uint32_t> visit_stamps;
+
+	/// Distances of visited cells from the start of the search.
+	std::vector<uint32_t> bfs_distances;
+
+	/// Preallocated queue of the breadth-first search.
+	std::vector<uint32_t> bfs_queue;
+
 };
 
 } /* namespace environments */
@@ -45,17 +45,34 @@ MNISTDigit::MNISTDigit(std::string node_name_) : Environment(node_name_),
 
 }
 
+MNISTDigit::MNISTDigit (const mic::environments::MNISTDigit & md_) : Environment(md_.getNodeName()+"_copy"),
+	mnist_importer("mnist_importer_copy"),
+	sample_number("sample_number", md_.sample_number),
+	agent_x("agent_x", md_.agent_x),
+	agent_y("agent_y", md_.agent_y),
+	goal_x("goal_x", md_.goal_x),
+	goal_y("goal_y", md_.goal_y)
+{
+	// Register properties - so their values can be overridden (read from the configuration file).
+	registerProperty(sample_number);
+	registerProperty(agent_x);
+	registerProperty(agent_y);
+	registerProperty(goal_x);
+	registerProperty(goal_y);
+
+	// Copy size and (deep copy) the environment - the dataset is not copied, so the copy cannot generate new environments.
+	copyEnvironment(md_);
+	optimal_path_length = md_.optimal_path_length;
+}
+
 MNISTDigit::~MNISTDigit() {
 	// TODO Auto-generated destructor stub
 }
 
 mic::environments::MNISTDigit & MNISTDigit::operator= (const mic::environments::MNISTDigit & md_) {
-	width = md_.width;
-	height = md_.height;
-	channels = md_.channels;
-	initial_position = md_.initial_position;
-	environment_grid = md_.environment_grid;
-	observation_grid = md_.observation_grid;
+	// Copy size and (deep copy) the environment.
+	copyEnvironment(md_);
+	optimal_path_length = md_.optimal_path_length;
 
 	return *this;
 }
@@ -83,8 +100,9 @@ void MNISTDigit::initializePropertyDependentVariables() {
 }
 
 void MNISTDigit::initializeEnvironment() {
-	// Reset the grid.
+	// Reset the grid - the padded grid will be rebuilt from the new one.
 	environment_grid->zeros();
+	invalidatePaddedGrid();
 
 	if (mnist_importer.size() > 0) {
 		mic::types::MNISTSample<> sample;
@@ -107,19 +125,24 @@ void MNISTDigit::initializeEnvironment() {
 	size_t ax,ay,gx,gy;
 
 	// Set agent coordinates.
-	ax = (agent_x < 0) ? RAN_GEN->uniRandInt(0,width) : agent_x;
-	ay = (agent_y < 0) ? RAN_GEN->uniRandInt(0,height) : agent_y;
+	mic::types::Position2D agent = randomPosition(0, width-1, 0, height-1);
+	ax = (agent_x < 0) ? agent.x : agent_x;
+	ay = (agent_y < 0) ? agent.y : agent_y;
 	// Set initial position
 	initial_position.set(ax,ay);
 	moveAgentToInitialPosition();
 
 	// Set goal coordinates.
-	gx = (goal_x < 0) ? RAN_GEN->uniRandInt(0,width) : goal_x;
-	gy = (goal_y < 0) ? RAN_GEN->uniRandInt(0,height) : goal_y;
+	mic::types::Position2D goal = randomPosition(0, width-1, 0, height-1);
+	gx = (goal_x < 0) ? goal.x : goal_x;
+	gy = (goal_y < 0) ? goal.y : goal_y;
 	(*environment_grid)({gx,gy,(size_t)MNISTDigitChannels::Goals}) = 10;
 
 	// Calculate the optimal path length.
 	optimal_path_length = abs((int)ax-(int)gx) + abs((int)ay-(int)gy);
+
+	// Encode the observations of all positions (if required).
+	buildObservationCache();
 }
 
 std::string MNISTDigit::toString(mic::types::TensorXfPtr env_) {
@@ -189,6 +212,13 @@ mic::types::MatrixXfPtr MNISTDigit::encodeObservation() {
 		mic::types::Position2D p = getAgentPosition();
 		LOG(LDEBUG) << p;
 
+		if (observation_cache_valid) {
+			// Copy the cached observation.
+			mic::types::MatrixXfPtr encoded_obs (new mic::types::MatrixXf(getObservationSize(), 1));
+			encoded_obs->col(0) = cached_observations->col(getObservationCacheColumn(p));
+			return encoded_obs;
+		}//: if
+
 		// Get observation.
 		mic::types::TensorXfPtr obs = getObservation();
 		// Temporarily reshape the observation grid.
@@ -207,26 +237,8 @@ mic::types::MatrixXfPtr MNISTDigit::encodeObservation() {
 
 mic::types::TensorXfPtr MNISTDigit::getObservation() {
 	LOG(LDEBUG) << "getObservation()";
-	// Reset.
-	observation_grid->zeros();
-
-	size_t delta = (roi_size-1)/2;
-	mic::types::Position2D p = getAgentPosition();
-
-	// Copy data.
-	for (long oy=0, ey=(p.y-delta); oy<(long)roi_size; oy++, ey++){
-		for (long ox=0, ex=(p.x-delta); ox<(long)roi_size; ox++, ex++) {
-			// Check grid boundaries.
-			if ((ex < 0) || ((size_t)ex >= width) || (ey < 0) || ((size_t)ey >= height)){
-				// Do nothing...
-				continue;
-			}//: if
-			// Else : copy data for all channels.
-			(*observation_grid)({(size_t)ox,(size_t)oy, (size_t)MNISTDigitChannels::Goals}) = (*environment_grid)({(size_t)ex,(size_t)ey, (size_t)MNISTDigitChannels::Goals});
-			(*observation_grid)({(size_t)ox,(size_t)oy, (size_t)MNISTDigitChannels::Pixels}) = (*environment_grid)({(size_t)ex,(size_t)ey, (size_t)MNISTDigitChannels::Pixels});
-			(*observation_grid)({(size_t)ox,(size_t)oy, (size_t)MNISTDigitChannels::Agent}) = (*environment_grid)({(size_t)ex,(size_t)ey, (size_t)MNISTDigitChannels::Agent});
-		}//: for x
-	}//: for y
+	// Copy the ROI (all channels).
+	extractObservation(getAgentPosition(), 0, channels);
 
 	//LOG(LDEBUG) << std::endl << toString(observation_grid);
 
@@ -262,6 +274,8 @@ bool MNISTDigit::moveAgentToPosition(mic::types::Position2D pos_) {
 	(*environment_grid)({(size_t)old.x, (size_t)old.y, (size_t)MNISTDigitChannels::Agent}) = 0;
 	// Set new.
 	(*environment_grid)({(size_t)pos_.x, (size_t)pos_.y, (size_t)MNISTDigitChannels::Agent}) = 1;
+	setPaddedCell(old.x, old.y, (size_t)MNISTDigitChannels::Agent, 0);
+	setPaddedCell(pos_.x, pos_.y, (size_t)MNISTDigitChannels::Agent, 1);
 
 	return true;
 }
@@ -56,7 +56,7 @@ public:
 	MNISTDigit(std::string node_name_ = "mnist_digit");
 
 	/*!
-	 * Copying constructor.
+	 * Copying constructor. Creates a deep copy of the environment state.
 	 * @param md_ MNIST digit to be cloned.
 	 */
 	MNISTDigit (const mic::environments::MNISTDigit & md_);
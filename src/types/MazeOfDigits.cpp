@@ -40,13 +40,9 @@ MazeOfDigits::MazeOfDigits (const mic::environments::MazeOfDigits & md_) : Envir
 {
 	// Register properties - so their values can be overridden (read from the configuration file).
 	registerProperty(type);
-	// Not used, but still let's copy it.
-	width = md_.width;
-	height = md_.height;
-	channels = md_.channels;
-	initial_position = md_.initial_position;
-	environment_grid = md_.environment_grid;
-	observation_grid = md_.observation_grid;
+	// Copy size and (deep copy) the environment.
+	copyEnvironment(md_);
+	optimal_path_length = md_.optimal_path_length;
 }
 
 
@@ -55,12 +51,10 @@ MazeOfDigits::~MazeOfDigits() {
 }
 
 mic::environments::MazeOfDigits & MazeOfDigits::operator= (const mic::environments::MazeOfDigits & md_) {
-	width = md_.width;
-	height = md_.height;
-	channels = md_.channels;
-	initial_position = md_.initial_position;
-	environment_grid = md_.environment_grid;
-	observation_grid = md_.observation_grid;
+	type = md_.type;
+	// Copy size and (deep copy) the environment.
+	copyEnvironment(md_);
+	optimal_path_length = md_.optimal_path_length;
 
 	return *this;
 }
@@ -71,6 +65,9 @@ void MazeOfDigits::initializePropertyDependentVariables() {
 }
 
 void MazeOfDigits::initializeEnvironment() {
+	// The padded grid will be rebuilt from the generated maze.
+	invalidatePaddedGrid();
+
 	// Generate adequate maze.
 	switch(type) {
 		case 0 : initExemplaryMaze(); break;
@@ -90,6 +87,9 @@ void MazeOfDigits::initializeEnvironment() {
 	} else {
 		observation_grid->resize({width, height, 1});
 	}//: else
+
+	// Encode the observations of all positions (if required).
+	buildObservationCache();
 }
 
 void MazeOfDigits::initExemplaryMaze() {
@@ -158,7 +158,7 @@ void MazeOfDigits::reRandomAgentPosition() {
 	mic::types::Position2D agent;
 	while (1) {
 		// Random position.
-		agent.rand(0, width - 1, 0, height - 1);
+		agent = randomPosition(0, width - 1, 0, height - 1);
 
 		// Validate pose.
 		if ((*environment_grid)({ (size_t)agent.x, (size_t)agent.y, (size_t)MazeOfDigitsChannels::Goals }) != 0)
@@ -190,8 +190,11 @@ void MazeOfDigits::initFullyRandomMaze() {
 	environment_grid->resize({width, height, channels});
 	environment_grid->zeros();
 
+	// Get the (seedable) random generator of the environment.
+	mic::types::Xoshiro256 & rng_gen = getRandomGenerator();
+
 	// Place the agent.
-	mic::types::Position2D agent(0, width-1, 0, height-1);
+	mic::types::Position2D agent = randomPosition(0, width-1, 0, height-1);
 	initial_position = agent;
 	moveAgentToPosition(initial_position);
 
@@ -200,7 +203,7 @@ void MazeOfDigits::initFullyRandomMaze() {
 	mic::types::Position2D goal;
 	while(1) {
 		// Random position.
-		goal.rand(0, width-1, 0, height-1);
+		goal = randomPosition(0, width-1, 0, height-1);
 
 		// Validate pose.
 		if ((*environment_grid)({(size_t)goal.x, (size_t)goal.y, (size_t)MazeOfDigitsChannels::Agent}) != 0)
@@ -215,10 +218,6 @@ void MazeOfDigits::initFullyRandomMaze() {
 	// Calculate the optimal path length.
 	optimal_path_length = abs((int)goal.x-(int)agent.x) + abs((int)goal.y-(int)agent.y);
 
-	// Initialize random device and generator.
-	std::random_device rd;
-	std::mt19937_64 rng_mt19937_64(rd());
-
 	// Initialize uniform integer distribution for digit.
 	std::uniform_int_distribution<size_t> d_dist(0, 8);
 
@@ -232,7 +231,7 @@ void MazeOfDigits::initFullyRandomMaze() {
 				continue;
 
 			// Random variables.
-			size_t d = d_dist(rng_mt19937_64);
+			size_t d = d_dist(rng_gen);
 			(*environment_grid)({(size_t)x, (size_t)y, (size_t)MazeOfDigitsChannels::Digits}) = d;
 
 		}//:for
@@ -257,8 +256,11 @@ void MazeOfDigits::initRandomStructuredMaze() {
 	environment_grid->resize({width, height, channels});
 	environment_grid->zeros();
 
+	// Get the (seedable) random generator of the environment.
+	mic::types::Xoshiro256 & rng_gen = getRandomGenerator();
+
 	// Place the agent.
-	mic::types::Position2D agent(0, width-1, 0, height-1);
+	mic::types::Position2D agent = randomPosition(0, width-1, 0, height-1);
 	initial_position = agent;
 	moveAgentToPosition(initial_position);
 
@@ -267,7 +269,7 @@ void MazeOfDigits::initRandomStructuredMaze() {
 	mic::types::Position2D goal;
 	while(1) {
 		// Random position.
-		goal.rand(0, width-1, 0, height-1);
+		goal = randomPosition(0, width-1, 0, height-1);
 
 		// Validate pose.
 		if ((*environment_grid)({(size_t)goal.x, (size_t)goal.y, (size_t)MazeOfDigitsChannels::Agent}) != 0)
@@ -282,10 +284,6 @@ void MazeOfDigits::initRandomStructuredMaze() {
 	// Calculate the optimal path length.
 	optimal_path_length = abs((int)goal.x-(int)agent.x) + abs((int)goal.y-(int)agent.y);
 
-	// Initialize random device and generator.
-	std::random_device rd;
-	std::mt19937_64 rng_mt19937_64(rd());
-
 
 	// Fill the "rest" with random digits.
 	for(size_t x=0; x<width; x++ ){
@@ -311,7 +309,7 @@ void MazeOfDigits::initRandomStructuredMaze() {
 
 			// Random variables.
 			std::uniform_int_distribution<size_t> d_dist(min, max);
-			size_t d = d_dist(rng_mt19937_64);
+			size_t d = d_dist(rng_gen);
 			LOG(LDEBUG)<< " x = " << x << " goal.x = " << goal.x << " y = " << y << " goal.y = " << goal.y << " dist = " << dist << " scaled_dist = " << scaled_dist << " min = " << min << " max = " << max << " d = " << d;
 			(*environment_grid)({(size_t)x, (size_t)y, (size_t)MazeOfDigitsChannels::Digits}) = d;
 
@@ -338,8 +336,11 @@ void MazeOfDigits::initRandomPathMaze() {
 	environment_grid->zeros();
 //	environment_grid->setValue(-1);
 
+	// Get the (seedable) random generator of the environment.
+	mic::types::Xoshiro256 & rng_gen = getRandomGenerator();
+
 	// Place the agent.
-	mic::types::Position2D agent(0, width-1, 0, height-1);
+	mic::types::Position2D agent = randomPosition(0, width-1, 0, height-1);
 	initial_position = agent;
 	moveAgentToPosition(initial_position);
 
@@ -348,7 +349,7 @@ void MazeOfDigits::initRandomPathMaze() {
 	mic::types::Position2D goal;
 	while(1) {
 		// Random position.
-		goal.rand(2, width-3, 2, height-3);
+		goal = randomPosition(2, width-3, 2, height-3);
 
 		// Validate pose.
 		if ((*environment_grid)({(size_t)goal.x, (size_t)goal.y, (size_t)MazeOfDigitsChannels::Agent}) != 0)
@@ -363,10 +364,6 @@ void MazeOfDigits::initRandomPathMaze() {
 	// Calculate the optimal path length.
 	optimal_path_length = abs((int)goal.x-(int)agent.x) + abs((int)goal.y-(int)agent.y);
 
-	// Initialize random device and generator.
-	std::random_device rd;
-	std::mt19937_64 rng_mt19937_64(rd());
-
 	// Check quarter and calculate "main path direction".
 	types::NESWAction dir_min, dir_max;
 	if (((size_t)goal.x < width/2) && ((size_t)goal.y < height/2)) {
@@ -411,8 +408,8 @@ void MazeOfDigits::initRandomPathMaze() {
 
 		// "Move" ;)
 		types::NESWAction action;
-		action.dx = x_dist(rng_mt19937_64);
-		action.dy = y_dist(rng_mt19937_64);
+		action.dx = x_dist(rng_gen);
+		action.dy = y_dist(rng_gen);
 		cur = cur + action;
 
 		if ((cur.x < 0) || (cur.y < 0) || ((size_t)cur.x >= width) || ((size_t)cur.y >= height))
@@ -441,7 +438,7 @@ void MazeOfDigits::initRandomPathMaze() {
 
 		// Random variables.
 		std::uniform_int_distribution<size_t> d_dist(min, max);
-		size_t d = d_dist(rng_mt19937_64);
+		size_t d = d_dist(rng_gen);
 		LOG(LDEBUG)<< " x = " << cur.x << " goal.x = " << goal.x << " y = " << cur.y << " goal.y = " << goal.y << " dist = " << dist << " scaled_dist = " << scaled_dist << " min = " << min << " max = " << max << " d = " << d;
 		(*environment_grid)({(size_t)cur.x, (size_t)cur.y, (size_t)MazeOfDigitsChannels::Digits}) = d;
 
@@ -457,10 +454,10 @@ void MazeOfDigits::initRandomPathMaze() {
 		std::uniform_int_distribution<size_t> d_dist(min, max);
 
 		// Check 4 neighbours.
-		setBiggerDigit(point.x, point.y-1, d_dist(rng_mt19937_64));
-		setBiggerDigit(point.x-1, point.y, d_dist(rng_mt19937_64));
-		setBiggerDigit(point.x+1, point.y, d_dist(rng_mt19937_64));
-		setBiggerDigit(point.x, point.y+1, d_dist(rng_mt19937_64));
+		setBiggerDigit(point.x, point.y-1, d_dist(rng_gen));
+		setBiggerDigit(point.x-1, point.y, d_dist(rng_gen));
+		setBiggerDigit(point.x+1, point.y, d_dist(rng_gen));
+		setBiggerDigit(point.x, point.y+1, d_dist(rng_gen));
 	}//:for
 
 	// "Grow the path" by 2.
@@ -473,14 +470,14 @@ void MazeOfDigits::initRandomPathMaze() {
 		std::uniform_int_distribution<size_t> d2_dist(min, max);
 
 		// Check 8 neighbours.
-		setBiggerDigit(point.x, point.y-2, d2_dist(rng_mt19937_64));
-		setBiggerDigit(point.x-1, point.y-1, d2_dist(rng_mt19937_64));
-		setBiggerDigit(point.x+1, point.y-1, d2_dist(rng_mt19937_64));
-		setBiggerDigit(point.x-2, point.y, d2_dist(rng_mt19937_64));
-		setBiggerDigit(point.x+2, point.y, d2_dist(rng_mt19937_64));
-		setBiggerDigit(point.x-1, point.y+1, d2_dist(rng_mt19937_64));
-		setBiggerDigit(point.x+1, point.y+1, d2_dist(rng_mt19937_64));
-		setBiggerDigit(point.x, point.y+2, d2_dist(rng_mt19937_64));
+		setBiggerDigit(point.x, point.y-2, d2_dist(rng_gen));
+		setBiggerDigit(point.x-1, point.y-1, d2_dist(rng_gen));
+		setBiggerDigit(point.x+1, point.y-1, d2_dist(rng_gen));
+		setBiggerDigit(point.x-2, point.y, d2_dist(rng_gen));
+		setBiggerDigit(point.x+2, point.y, d2_dist(rng_gen));
+		setBiggerDigit(point.x-1, point.y+1, d2_dist(rng_gen));
+		setBiggerDigit(point.x+1, point.y+1, d2_dist(rng_gen));
+		setBiggerDigit(point.x, point.y+2, d2_dist(rng_gen));
 	}//:for
 
 	// "Grow the path" by 3.
@@ -493,14 +490,14 @@ void MazeOfDigits::initRandomPathMaze() {
 		std::uniform_int_distribution<size_t> d3_dist(min, max);
 
 		// Check 8 neighbours.
-		setBiggerDigit(point.x+2, point.y-1, d3_dist(rng_mt19937_64));
-		setBiggerDigit(point.x+2, point.y+1, d3_dist(rng_mt19937_64));
-		setBiggerDigit(point.x-2, point.y-1, d3_dist(rng_mt19937_64));
-		setBiggerDigit(point.x-2, point.y+1, d3_dist(rng_mt19937_64));
-		setBiggerDigit(point.x+1, point.y-2, d3_dist(rng_mt19937_64));
-		setBiggerDigit(point.x+1, point.y+2, d3_dist(rng_mt19937_64));
-		setBiggerDigit(point.x-1, point.y-2, d3_dist(rng_mt19937_64));
-		setBiggerDigit(point.x-1, point.y+2, d3_dist(rng_mt19937_64));
+		setBiggerDigit(point.x+2, point.y-1, d3_dist(rng_gen));
+		setBiggerDigit(point.x+2, point.y+1, d3_dist(rng_gen));
+		setBiggerDigit(point.x-2, point.y-1, d3_dist(rng_gen));
+		setBiggerDigit(point.x-2, point.y+1, d3_dist(rng_gen));
+		setBiggerDigit(point.x+1, point.y-2, d3_dist(rng_gen));
+		setBiggerDigit(point.x+1, point.y+2, d3_dist(rng_gen));
+		setBiggerDigit(point.x-1, point.y-2, d3_dist(rng_gen));
+		setBiggerDigit(point.x-1, point.y+2, d3_dist(rng_gen));
 	}//:for
 
 	// Fill the "rest" with random digits.
@@ -509,7 +506,7 @@ void MazeOfDigits::initRandomPathMaze() {
 
 			// Random variables.
 			std::uniform_int_distribution<size_t> d_dist(0, 1);
-			size_t d = d_dist(rng_mt19937_64);
+			size_t d = d_dist(rng_gen);
 			if ((*environment_grid)({(size_t)x, (size_t)y, (size_t)MazeOfDigitsChannels::Digits}) == 0)
 				(*environment_grid)({(size_t)x, (size_t)y, (size_t)MazeOfDigitsChannels::Digits}) = d;
 
@@ -600,6 +597,13 @@ mic::types::MatrixXfPtr MazeOfDigits::encodeObservation() {
 		mic::types::Position2D p = getAgentPosition();
 		LOG(LDEBUG) << p;
 
+		if (observation_cache_valid) {
+			// Copy the cached observation.
+			mic::types::MatrixXfPtr encoded_obs (new mic::types::MatrixXf(getObservationSize(), 1));
+			encoded_obs->col(0) = cached_observations->col(getObservationCacheColumn(p));
+			return encoded_obs;
+		}//: if
+
 		// Get observation.
 		mic::types::TensorXfPtr obs = getObservation();
 		// Temporarily reshape the observation grid.
@@ -619,28 +623,8 @@ mic::types::MatrixXfPtr MazeOfDigits::encodeObservation() {
 
 mic::types::TensorXfPtr MazeOfDigits::getObservation() {
 	LOG(LDEBUG) << "getObservation()";
-	// Reset observation.
-	observation_grid->zeros();
-
-	size_t delta = (roi_size-1)/2;
-	mic::types::Position2D p = getAgentPosition();
-
-	// Copy data.
-	for (long oy=0, ey=(p.y-delta); oy<(long)roi_size; oy++, ey++){
-		for (long ox=0, ex=(p.x-delta); ox<(long)roi_size; ox++, ex++) {
-			// Check grid boundaries.
-			if ((ex < 0) || (ex >= (long)width) || (ey < 0) || (ey >= (long)height)){
-				// Place the wall only
-				//(*observation_grid)({(size_t)ox, (size_t)oy, (size_t)MazeOfDigitsChannels::Walls}) = 1;
-				continue;
-			}//: if
-			// Else : copy data for all channels.
-			//(*observation_grid)({(size_t)ox,(size_t)oy, (size_t)MazeOfDigitsChannels::Goals}) = (*environment_grid)({(size_t)ex,(size_t)ey, (size_t)MazeOfDigitsChannels::Goals});
-			(*observation_grid)({(size_t)ox,(size_t)oy, (size_t)MazeOfDigitsChannels::Digits}) = (*environment_grid)({(size_t)ex,(size_t)ey, (size_t)MazeOfDigitsChannels::Digits});
-			//(*observation_grid)({(size_t)ox,(size_t)oy, (size_t)MazeOfDigitsChannels::Walls}) = (*environment_grid)({(size_t)ex,(size_t)ey, (size_t)MazeOfDigitsChannels::Walls});
-			//(*observation_grid)({(size_t)ox,(size_t)oy, (size_t)MazeOfDigitsChannels::Agent}) = (*environment_grid)({(size_t)ex,(size_t)ey, (size_t)MazeOfDigitsChannels::Agent});
-		}//: for x
-	}//: for y
+	// Copy the ROI - only the digits channel is observed.
+	extractObservation(getAgentPosition(), (size_t)MazeOfDigitsChannels::Digits, 1);
 
 	//LOG(LDEBUG) << std::endl << gridToString(observation_grid);
 
@@ -697,6 +681,8 @@ bool MazeOfDigits::moveAgentToPosition(mic::types::Position2D pos_) {
 	(*environment_grid)({(size_t)old.x, (size_t)old.y, (size_t)MazeOfDigitsChannels::Agent}) = 0;
 	// Set new.
 	(*environment_grid)({(size_t)pos_.x, (size_t)pos_.y, (size_t)MazeOfDigitsChannels::Agent}) = 1;
+	setPaddedCell(old.x, old.y, (size_t)MazeOfDigitsChannels::Agent, 0);
+	setPaddedCell(pos_.x, pos_.y, (size_t)MazeOfDigitsChannels::Agent, 1);
 
 	return true;
 }
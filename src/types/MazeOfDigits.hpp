@@ -56,7 +56,7 @@ public:
 	MazeOfDigits(std::string node_name_ = "maze_of_digits");
 
 	/*!
-	 * Copying constructor.
+	 * Copying constructor. Creates a deep copy of the environment state.
 	 * @param md_ Maze of digits to be cloned.
 	 */
 	MazeOfDigits (const mic::environments::MazeOfDigits & md_);
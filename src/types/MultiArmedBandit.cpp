@@ -0,0 +1,153 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file MultiArmedBandit.cpp
+ * \brief Contains definitions of the methods of the n-armed bandit environment.
+ * \author tkornut
+ * \date Oct 18, 2026
+ */
+
+#include <types/MultiArmedBandit.hpp>
+
+namespace mic {
+namespace environments {
+
+MultiArmedBandit::MultiArmedBandit(std::string node_name_) : PropertyTree(node_name_),
+	reward_distribution("reward_distribution", (short)BanditRewardDistribution::Binomial),
+	reward_scale("reward_scale", 10),
+	reward_stddev("reward_stddev", 1.0),
+	seed("seed", -1),
+	number_of_arms(0),
+	rng_stream(0)
+{
+	// Register properties - so their values can be overridden (read from the configuration file).
+	registerProperty(reward_distribution);
+	registerProperty(reward_scale);
+	registerProperty(reward_stddev);
+	registerProperty(seed);
+}
+
+
+MultiArmedBandit::~MultiArmedBandit() {
+
+}
+
+
+void MultiArmedBandit::initializePropertyDependentVariables() {
+	// Empty - everything will be initialized in initialization of arms.
+}
+
+
+void MultiArmedBandit::initializeArms(size_t number_of_arms_, size_t number_of_problems_) {
+	number_of_arms = number_of_arms_;
+
+	// Seed the generators - every problem gets its own stream, obtained by a single jump from the stream of the previous one.
+	uint64_t s = (seed < 0) ? ((uint64_t)std::random_device()() << 32) ^ std::random_device()() : (uint64_t)seed;
+	rngs.resize(number_of_problems_);
+	for (size_t p=0; p<number_of_problems_; p++) {
+		if (p == 0)
+			rngs[p].seed(s, rng_stream);
+		else {
+			rngs[p] = rngs[p-1];
+			rngs[p].jump();
+		}//: else
+	}//: for
+	normals.assign(number_of_problems_, std::normal_distribution<float>());
+
+	// Draw probabilities of arms and find the best ones.
+	probabilities.resize(number_of_problems_ * number_of_arms_);
+	binomials.clear();
+	binomials.reserve(number_of_problems_ * number_of_arms_);
+	best_arms.assign(number_of_problems_, 0);
+	for (size_t p=0; p<number_of_problems_; p++) {
+		float* probs = probabilities.data() + p * number_of_arms_;
+		for (size_t i=0; i<number_of_arms_; i++) {
+			probs[i] = uniform(rngs[p]);
+			binomials.push_back(std::binomial_distribution<int>((int)reward_scale, probs[i]));
+			if (probs[i] > probs[best_arms[p]])
+				best_arms[p] = i;
+		}//: for i
+	}//: for p
+}
+
+
+template <>
+inline float MultiArmedBandit::sample<BanditRewardDistribution::Binomial>(size_t arm_, size_t problem_) {
+	return (float)binomials[problem_ * number_of_arms + arm_](rngs[problem_]);
+}
+
+
+template <>
+inline float MultiArmedBandit::sample<BanditRewardDistribution::Bernoulli>(size_t arm_, size_t problem_) {
+	return (uniform(rngs[problem_]) < probabilities[problem_ * number_of_arms + arm_]) ? (float)reward_scale : 0.0f;
+}
+
+
+template <>
+inline float MultiArmedBandit::sample<BanditRewardDistribution::Gaussian>(size_t arm_, size_t problem_) {
+	return (float)reward_scale * probabilities[problem_ * number_of_arms + arm_] + (float)reward_stddev * normals[problem_](rngs[problem_]);
+}
+
+
+float MultiArmedBandit::pull(size_t arm_, size_t problem_) {
+	switch((BanditRewardDistribution)(short)reward_distribution) {
+		case BanditRewardDistribution::Bernoulli: return sample<BanditRewardDistribution::Bernoulli>(arm_, problem_);
+		case BanditRewardDistribution::Gaussian: return sample<BanditRewardDistribution::Gaussian>(arm_, problem_);
+		case BanditRewardDistribution::Binomial:
+		default: return sample<BanditRewardDistribution::Binomial>(arm_, problem_);
+	}//: switch
+}
+
+
+void MultiArmedBandit::pull(const size_t* arms_, float* rewards_, size_t number_of_pulls_, size_t problem_) {
+	// Select the distribution once - the loops are free of branches on the distribution type.
+	switch((BanditRewardDistribution)(short)reward_distribution) {
+		case BanditRewardDistribution::Bernoulli:
+			for (size_t i=0; i<number_of_pulls_; i++)
+				rewards_[i] = sample<BanditRewardDistribution::Bernoulli>(arms_[i], problem_);
+			break;
+		case BanditRewardDistribution::Gaussian:
+			for (size_t i=0; i<number_of_pulls_; i++)
+				rewards_[i] = sample<BanditRewardDistribution::Gaussian>(arms_[i], problem_);
+			break;
+		case BanditRewardDistribution::Binomial:
+		default:
+			for (size_t i=0; i<number_of_pulls_; i++)
+				rewards_[i] = sample<BanditRewardDistribution::Binomial>(arms_[i], problem_);
+	}//: switch
+}
+
+
+void MultiArmedBandit::pullProblems(const size_t* arms_, float* rewards_, size_t first_problem_, size_t number_of_problems_) {
+	// Select the distribution once - the loops are free of branches on the distribution type.
+	switch((BanditRewardDistribution)(short)reward_distribution) {
+		case BanditRewardDistribution::Bernoulli:
+			for (size_t i=0; i<number_of_problems_; i++)
+				rewards_[i] = sample<BanditRewardDistribution::Bernoulli>(arms_[i], first_problem_ + i);
+			break;
+		case BanditRewardDistribution::Gaussian:
+			for (size_t i=0; i<number_of_problems_; i++)
+				rewards_[i] = sample<BanditRewardDistribution::Gaussian>(arms_[i], first_problem_ + i);
+			break;
+		case BanditRewardDistribution::Binomial:
+		default:
+			for (size_t i=0; i<number_of_problems_; i++)
+				rewards_[i] = sample<BanditRewardDistribution::Binomial>(arms_[i], first_problem_ + i);
+	}//: switch
+}
+
+} /* namespace environments */
+} /* namespace mic */
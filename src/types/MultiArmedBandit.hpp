@@ -0,0 +1,216 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file MultiArmedBandit.hpp
+ * \brief Contains declaration of the n-armed bandit environment with pluggable reward distributions.
+ * \author tkornut
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_TYPES_MULTIARMEDBANDIT_HPP_
+#define SRC_TYPES_MULTIARMEDBANDIT_HPP_
+
+#include <vector>
+#include <random>
+
+#include <types/Xoshiro256.hpp>
+#include <configuration/PropertyTree.hpp>
+
+namespace mic {
+namespace environments {
+
+/*!
+ * \brief Distributions of rewards returned by the arms.
+ * \author tkornuta
+ */
+enum class BanditRewardDistribution : short {
+	Binomial = 0, ///< Number of successes in reward_scale trials with the arm probability (the "classic" reward of the bandit applications).
+	Bernoulli, ///< reward_scale with the arm probability, zero otherwise.
+	Gaussian ///< Normal distribution with mean reward_scale * arm probability and reward_stddev deviation.
+};
+
+
+/*!
+ * \brief Class emulating the n-armed bandit: every arm is characterized by a hidden probability, drawn uniformly from [0,1).
+ * The rewards are sampled in constant time (a single draw from the distribution instead of a loop over trials).
+ * The expected reward of an arm is equal to reward_scale * probability for every distribution.
+ * The class can hold many independent bandit problems (e.g. runs of a testbed) stored as structure of arrays,
+ * each with its own generator, so disjoint sets of problems can be pulled from different threads.
+ * \author tkornuta
+ */
+class MultiArmedBandit : public mic::configuration::PropertyTree {
+public:
+	/*!
+	 * Constructor. Registers properties.
+	 * @param node_name_ Name of the node in configuration file.
+	 */
+	MultiArmedBandit(std::string node_name_ = "bandit");
+
+	/*!
+	 * Destructor. Empty.
+	 */
+	virtual ~MultiArmedBandit();
+
+	/*!
+	 * Initializes all variables that are property-dependent.
+	 */
+	virtual void initializePropertyDependentVariables();
+
+	/*!
+	 * Seeds the generators (with the seed property) and draws the (hidden) probabilities of arms of all problems.
+	 * @param number_of_arms_ Number of arms.
+	 * @param number_of_problems_ Number of independent bandit problems (default: 1).
+	 */
+	void initializeArms(size_t number_of_arms_, size_t number_of_problems_ = 1);
+
+	/*!
+	 * Selects the stream of the generator - parallel simulations should use different streams.
+	 * Consecutive problems use consecutive streams, starting from the selected one. Takes effect at the next initialization of arms.
+	 * @param stream_ Index of the stream.
+	 */
+	void setRandomStream(size_t stream_) { rng_stream = stream_; }
+
+	/*!
+	 * Pulls the arm.
+	 * @param arm_ Index of the arm.
+	 * @param problem_ Index of the problem (default: 0).
+	 * @return Sampled reward.
+	 */
+	float pull(size_t arm_, size_t problem_ = 0);
+
+	/*!
+	 * Pulls the arms of a single problem one after another - the distribution is selected once for the whole batch.
+	 * @param arms_ Indices of the arms.
+	 * @param rewards_ Output array for the sampled rewards.
+	 * @param number_of_pulls_ Number of pulls (size of both arrays).
+	 * @param problem_ Index of the problem (default: 0).
+	 */
+	void pull(const size_t* arms_, float* rewards_, size_t number_of_pulls_, size_t problem_ = 0);
+
+	/*!
+	 * Pulls a single arm in each of the consecutive problems - the distribution is selected once for the whole batch.
+	 * Calls for disjoint ranges of problems can be performed in parallel.
+	 * @param arms_ Indices of the arms (arms_[i] is pulled in problem first_problem_ + i).
+	 * @param rewards_ Output array for the sampled rewards.
+	 * @param first_problem_ Index of the first problem.
+	 * @param number_of_problems_ Number of problems (size of both arrays).
+	 */
+	void pullProblems(const size_t* arms_, float* rewards_, size_t first_problem_, size_t number_of_problems_);
+
+	/*!
+	 * Returns the number of arms.
+	 */
+	size_t getNumberOfArms() { return number_of_arms; }
+
+	/*!
+	 * Returns the number of problems.
+	 */
+	size_t getNumberOfProblems() { return best_arms.size(); }
+
+	/*!
+	 * Returns the (hidden) probability of the arm.
+	 * @param arm_ Index of the arm.
+	 * @param problem_ Index of the problem (default: 0).
+	 */
+	float getArmProbability(size_t arm_, size_t problem_ = 0) { return probabilities[problem_ * number_of_arms + arm_]; }
+
+	/*!
+	 * Returns the expected reward of the arm.
+	 * @param arm_ Index of the arm.
+	 * @param problem_ Index of the problem (default: 0).
+	 */
+	float getExpectedReward(size_t arm_, size_t problem_ = 0) { return (float)reward_scale * getArmProbability(arm_, problem_); }
+
+	/*!
+	 * Returns the maximal expected reward (reward_scale) - used for normalization of rewards.
+	 */
+	float getMaxReward() { return (float)reward_scale; }
+
+	/*!
+	 * Returns the index of the arm with the highest probability.
+	 * @param problem_ Index of the problem (default: 0).
+	 */
+	size_t getBestArm(size_t problem_ = 0) { return best_arms[problem_]; }
+
+	/*!
+	 * Returns the probability of the best arm.
+	 * @param problem_ Index of the problem (default: 0).
+	 */
+	float getBestArmProbability(size_t problem_ = 0) { return getArmProbability(best_arms[problem_], problem_); }
+
+private:
+	/*!
+	 * Returns a random real from [0,1).
+	 * @param rng_ Generator.
+	 */
+	static inline float uniform(mic::types::Xoshiro256 & rng_) {
+		return (float)(rng_() >> 40) * (1.0f / 16777216.0f);
+	}
+
+	/*!
+	 * Samples the reward of the arm from the selected distribution.
+	 * @param arm_ Index of the arm.
+	 * @param problem_ Index of the problem.
+	 */
+	template <BanditRewardDistribution Distribution>
+	inline float sample(size_t arm_, size_t problem_);
+
+	/*!
+	 * Property: distribution of rewards (0: binomial, 1: Bernoulli, 2: Gaussian).
+	 */
+	mic::configuration::Property<short> reward_distribution;
+
+	/*!
+	 * Property: scale of rewards - number of trials of the binomial distribution, reward of the Bernoulli distribution
+	 * and multiplier of the mean of the Gaussian distribution.
+	 */
+	mic::configuration::Property<size_t> reward_scale;
+
+	/// Property: standard deviation of the Gaussian distribution.
+	mic::configuration::Property<float> reward_stddev;
+
+	/*!
+	 * Property: seed of the generator.
+	 * Setting seed < 0 means that the generator will be seeded by std::random_device.
+	 */
+	mic::configuration::Property<long> seed;
+
+	/// Number of arms.
+	size_t number_of_arms;
+
+	/// Probabilities of arms - [problem][arm].
+	std::vector<float> probabilities;
+
+	/// Binomial distributions of arms (constructed once, as their construction is expensive) - [problem][arm].
+	std::vector<std::binomial_distribution<int> > binomials;
+
+	/// Standard normal distributions - one per problem (the distribution caches the second generated value).
+	std::vector<std::normal_distribution<float> > normals;
+
+	/// Indices of the best arms - one per problem.
+	std::vector<size_t> best_arms;
+
+	/// Generators used for drawing of probabilities and sampling of rewards - one per problem.
+	std::vector<mic::types::Xoshiro256> rngs;
+
+	/// Index of the stream of the generator.
+	size_t rng_stream;
+};
+
+} /* namespace environments */
+} /* namespace mic */
+
+#endif /* SRC_TYPES_MULTIARMEDBANDIT_HPP_ */
@@ -0,0 +1,181 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file ObservationExperienceMemory.hpp
+ * \brief Contains declaration of a thread-safe experience memory storing encoded observations (used by asynchronous learners).
+ * \author tkornut
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_TYPES_OBSERVATIONEXPERIENCEMEMORY_HPP_
+#define SRC_TYPES_OBSERVATIONEXPERIENCEMEMORY_HPP_
+
+#include <types/Position2D.hpp>
+#include <types/MatrixTypes.hpp>
+#include <types/ConcurrentExperienceMemory.hpp>
+
+#include <deque>
+
+namespace mic {
+namespace types {
+
+/*!
+ * \brief Structure storing an experience in the form of encoded observations, so it can be replayed without access to the environment.
+ * Besides the observations it stores the (discounted) reward, the discount applied to the value of the last observation
+ * and the mask of actions allowed in the last state (required for the computation of max Q).
+ * \author tkornuta
+ */
+struct ObservationExperience {
+	/// Encoded observation at time t.
+	mic::types::MatrixXfPtr o_t;
+
+	/// Action at time t.
+	mic::types::NESWAction a_t;
+
+	/// Encoded observation at time t+1 (or t+n in the case of multi-step experiences).
+	mic::types::MatrixXfPtr o_t_prim;
+
+	/// Mask of actions allowed in the state at time t+1 (t+n).
+	bool allowed_actions_t_prim[4];
+
+	/// Discounted sum of rewards collected between t and t+n.
+	float reward;
+
+	/// Discount factor applied to the value of o_t_prim (gamma^n, zero if the chain has ended).
+	float discount;
+
+	/*!
+	 * Default constructor.
+	 * @param o_t_ Encoded observation at time t.
+	 * @param a_t_ Action at time t.
+	 * @param o_t_prim_ Encoded observation at time t+1.
+	 * @param allowed_actions_t_prim_ Mask of actions allowed at time t+1 (array of 4 flags: N, E, S, W).
+	 */
+	ObservationExperience(mic::types::MatrixXfPtr o_t_, mic::types::NESWAction a_t_, mic::types::MatrixXfPtr o_t_prim_, const bool* allowed_actions_t_prim_) {
+		o_t = o_t_;
+		a_t = a_t_;
+		o_t_prim = o_t_prim_;
+		for (size_t a=0; a<4; a++)
+			allowed_actions_t_prim[a] = allowed_actions_t_prim_[a];
+		reward = 0.0f;
+		discount = 0.0f;
+	}
+
+};
+
+/*!
+ * \brief Shared pointer to observation experience object.
+ * \author tkornuta
+ */
+typedef std::shared_ptr < mic::types::ObservationExperience> ObservationExperiencePtr;
+
+
+/*!
+ * \brief Thread-safe memory of observation experiences - filled by actors and sampled by a learner.
+ * \author tkornuta
+ */
+typedef mic::types::ConcurrentExperienceMemory<mic::types::ObservationExperience> ObservationExperienceMemory;
+
+
+/*!
+ * \brief Class accumulating multi-step (n-step) observation experiences of a single actor before passing them to the memory.
+ * \author tkornuta
+ */
+class ObservationExperienceChain {
+public:
+	/*!
+	 * Constructor.
+	 * @param memory_ Memory the completed experiences will be passed to.
+	 * @param horizon_ Number of steps (n) after which the experience is bootstrapped.
+	 * @param discount_ Discount factor (gamma).
+	 */
+	ObservationExperienceChain(mic::types::ObservationExperienceMemory & memory_, size_t horizon_, float discount_) :
+		memory(memory_), horizon((horizon_ > 0) ? horizon_ : 1), discount(discount_) { }
+
+	/*!
+	 * Adds a single transition (t -> t+1) - updates all pending chains and passes the completed ones to the memory.
+	 * @param exp_ Experience (o_t, a_t, o_t+1).
+	 * @param reward_ Reward received for the transition.
+	 * @param terminal_ Flag indicating that the state t+1 is terminal - all chains end here.
+	 * @param blocked_ Flag indicating that the move was not possible - only the chain starting with this transition ends here
+	 * (it is stored without bootstrapping), while the older chains continue.
+	 */
+	void addTransition(mic::types::ObservationExperiencePtr exp_, float reward_, bool terminal_, bool blocked_ = false) {
+		// Update all pending chains: accumulate the discounted reward and move their last observation.
+		for (mic::types::ObservationExperiencePtr exp : pending) {
+			exp->reward += exp->discount * reward_;
+			exp->discount = (terminal_) ? 0.0f : exp->discount * discount;
+			exp->o_t_prim = exp_->o_t_prim;
+			for (size_t a=0; a<4; a++)
+				exp->allowed_actions_t_prim[a] = exp_->allowed_actions_t_prim[a];
+		}//: for
+		for (size_t & length : lengths)
+			length++;
+
+		exp_->reward = reward_;
+		if (blocked_) {
+			// The chain starting with this transition is complete.
+			exp_->discount = 0.0f;
+			memory.add(exp_);
+		} else {
+			// Start a new chain.
+			exp_->discount = (terminal_) ? 0.0f : discount;
+			pending.push_back(exp_);
+			lengths.push_back(1);
+		}//: else
+
+		if (terminal_) {
+			flush();
+		} else if ((!pending.empty()) && (lengths.front() >= horizon)) {
+			// The oldest chain covers the whole horizon.
+			memory.add(pending.front());
+			pending.pop_front();
+			lengths.pop_front();
+		}//: else
+	}
+
+	/*!
+	 * Passes all pending experiences to the memory - should be called at the end of an episode.
+	 */
+	void flush() {
+		while (!pending.empty()) {
+			memory.add(pending.front());
+			pending.pop_front();
+			lengths.pop_front();
+		}//: while
+	}
+
+protected:
+	/// Memory the experiences are passed to.
+	mic::types::ObservationExperienceMemory & memory;
+
+	/// Multi-step horizon (n).
+	size_t horizon;
+
+	/// Discount factor.
+	float discount;
+
+	/// Experiences that do not cover the whole horizon yet.
+	std::deque<mic::types::ObservationExperiencePtr> pending;
+
+	/// Numbers of transitions covered by the pending experiences.
+	std::deque<size_t> lengths;
+};
+
+} /* namespace types */
+} /* namespace mic */
+
+#endif /* SRC_TYPES_OBSERVATIONEXPERIENCEMEMORY_HPP_ */
@@ -0,0 +1,127 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file QTable.hpp
+ * \brief Contains declaration of the flat table of state-action values used by tabular methods.
+ * \author tkornut
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_TYPES_QTABLE_HPP_
+#define SRC_TYPES_QTABLE_HPP_
+
+#include <vector>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+
+namespace mic {
+namespace types {
+
+/*!
+ * \brief Flat, contiguous table of state-action values - a row of 4 (NESW) values per state.
+ * Selection of the best action is branch-free: the values of forbidden actions are masked out with the allowed-action mask
+ * (bit a set if action a is allowed) and the argmax is computed as a tournament, which compilers turn into vector selects.
+ * Ties are resolved in favour of the action with lower index.
+ * \author tkornuta
+ */
+class QTable {
+public:
+	/*!
+	 * Constructor.
+	 * @param number_of_states_ Number of states.
+	 */
+	QTable(size_t number_of_states_ = 0) {
+		resize(number_of_states_);
+	}
+
+	/*!
+	 * Resizes the table and sets all values to zero.
+	 * @param number_of_states_ Number of states.
+	 */
+	void resize(size_t number_of_states_) {
+		number_of_states = number_of_states_;
+		values.assign(number_of_states * 4, 0.0f);
+	}
+
+	/*!
+	 * Sets all values to the given value.
+	 * @param value_ Value.
+	 */
+	void setValue(float value_) {
+		values.assign(number_of_states * 4, value_);
+	}
+
+	/// Returns the number of states.
+	inline size_t getNumberOfStates() { return number_of_states; }
+
+	/// Returns the reference to the value of the (state, action) pair.
+	inline float & operator()(size_t state_, size_t action_) { return values[state_ * 4 + action_]; }
+
+	/// Returns the pointer to the row of values of the given state.
+	inline float* row(size_t state_) { return values.data() + state_ * 4; }
+
+	/*!
+	 * Finds the best allowed action in the given state.
+	 * @param state_ State.
+	 * @param mask_ Mask of allowed actions.
+	 * @param best_value_ Returned value of the best action (-INF if no action is allowed).
+	 * @return Index of the best action, -1 if no action is allowed.
+	 */
+	inline int getBestAction(size_t state_, uint8_t mask_, float & best_value_) {
+		const float* q = row(state_);
+		const float ninf = -std::numeric_limits<float>::infinity();
+		// Mask out forbidden actions.
+		float m0 = (mask_ & 1) ? q[0] : ninf;
+		float m1 = (mask_ & 2) ? q[1] : ninf;
+		float m2 = (mask_ & 4) ? q[2] : ninf;
+		float m3 = (mask_ & 8) ? q[3] : ninf;
+		// Tournament.
+		bool b01 = m1 > m0;
+		float v01 = b01 ? m1 : m0;
+		int i01 = b01 ? 1 : 0;
+		bool b23 = m3 > m2;
+		float v23 = b23 ? m3 : m2;
+		int i23 = b23 ? 3 : 2;
+		bool b = v23 > v01;
+		best_value_ = b ? v23 : v01;
+		return (mask_ & 0xF) ? (b ? i23 : i01) : -1;
+	}
+
+	/*!
+	 * Returns the maximal value of allowed actions in the given state.
+	 * @param state_ State.
+	 * @param mask_ Mask of allowed actions.
+	 * @return Maximal value, -INF if no action is allowed.
+	 */
+	inline float getBestValue(size_t state_, uint8_t mask_) {
+		float best_value;
+		getBestAction(state_, mask_, best_value);
+		return best_value;
+	}
+
+private:
+	/// Number of states.
+	size_t number_of_states;
+
+	/// Values - row-major [state][action].
+	std::vector<float> values;
+};
+
+} /* namespace types */
+} /* namespace mic */
+
+#endif /* SRC_TYPES_QTABLE_HPP_ */
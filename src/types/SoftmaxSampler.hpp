@@ -0,0 +1,170 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file SoftmaxSampler.hpp
+ * \brief Contains declaration (and definition) of the incremental sampler from the softmax (Boltzmann) distribution.
+ * \author tkornut
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_TYPES_SOFTMAXSAMPLER_HPP_
+#define SRC_TYPES_SOFTMAXSAMPLER_HPP_
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+
+namespace mic {
+namespace types {
+
+/*!
+ * \brief Sampler from the softmax distribution over values, p(i) = exp(v_i/tau) / sum_j exp(v_j/tau).
+ * The (unnormalized) weights are stored in the leaves of a sum-tree, hence the change of a single value
+ * and the sampling are both O(log n), instead of recomputing (and scanning) the whole distribution.
+ * For numerical stability the weights are computed as exp((v_i - shift)/tau), where shift is the maximal value
+ * at the moment of the last rebuild; the tree is rebuilt (O(n), rarely) when the weights leave the safe range.
+ * \author tkornuta
+ */
+class SoftmaxSampler {
+public:
+	/*!
+	 * Constructor.
+	 * @param size_ Number of elements (e.g. arms).
+	 * @param tau_ Temperature.
+	 * @param value_ Initial value of all elements.
+	 */
+	SoftmaxSampler(size_t size_ = 0, double tau_ = 1.0, float value_ = 0.0f) {
+		initialize(size_, tau_, value_);
+	}
+
+	/*!
+	 * Sets the number of elements, temperature and the initial value of all elements.
+	 * @param size_ Number of elements (e.g. arms).
+	 * @param tau_ Temperature.
+	 * @param value_ Initial value of all elements.
+	 */
+	void initialize(size_t size_, double tau_, float value_ = 0.0f) {
+		size = size_;
+		tau = tau_;
+		// Number of leaves is the smallest power of two not smaller than size (padding leaves have zero weight).
+		leaves = 1;
+		while (leaves < size)
+			leaves <<= 1;
+		values.assign(size, value_);
+		rebuild();
+	}
+
+	/*!
+	 * Changes the value of a single element - O(log n).
+	 * @param index_ Index of the element.
+	 * @param value_ New value.
+	 */
+	void setValue(size_t index_, float value_) {
+		values[index_] = value_;
+		double log_weight = (value_ - shift) / tau;
+		// The weight would be too big - rebuild with the new maximum.
+		if (log_weight > MAX_LOG_WEIGHT) {
+			rebuild();
+			return;
+		}//: if
+
+		// Update the leaf and sums on the path to the root.
+		size_t node = leaves + index_;
+		tree[node] = std::exp(log_weight);
+		for (node >>= 1; node > 0; node >>= 1)
+			tree[node] = tree[2 * node] + tree[2 * node + 1];
+
+		// All weights are (almost) vanishing - rebuild with the new maximum.
+		if (tree[1] < MIN_TOTAL_WEIGHT)
+			rebuild();
+	}
+
+	/// Returns the value of the element.
+	inline float getValue(size_t index_) { return values[index_]; }
+
+	/// Returns the probability of selection of the element.
+	inline double getProbability(size_t index_) { return tree[leaves + index_] / tree[1]; }
+
+	/// Returns the number of elements.
+	inline size_t getSize() { return size; }
+
+	/*!
+	 * Samples the element - O(log n).
+	 * @param u_ Random number from [0,1).
+	 * @return Index of the sampled element.
+	 */
+	size_t sample(double u_) {
+		double r = u_ * tree[1];
+		size_t node = 1;
+		while (node < leaves) {
+			size_t left = 2 * node;
+			// Go right only if the right subtree has non-zero weight (protects against the rounding errors).
+			if ((r < tree[left]) || (tree[left + 1] <= 0.0))
+				node = left;
+			else {
+				r -= tree[left];
+				node = left + 1;
+			}//: else
+		}//: while
+		return node - leaves;
+	}
+
+private:
+	/*!
+	 * Recomputes the shift (the maximal value) and all weights - O(n).
+	 */
+	void rebuild() {
+		shift = 0.0f;
+		for (size_t i=0; i<size; i++)
+			if ((i == 0) || (values[i] > shift))
+				shift = values[i];
+
+		tree.assign(2 * leaves, 0.0);
+		for (size_t i=0; i<size; i++)
+			tree[leaves + i] = std::exp((values[i] - shift) / tau);
+		for (size_t node = leaves - 1; node > 0; node--)
+			tree[node] = tree[2 * node] + tree[2 * node + 1];
+	}
+
+	/// Maximal logarithm of the weight accepted without rebuild (exp(MAX_LOG_WEIGHT) times number of elements must fit in double).
+	static constexpr double MAX_LOG_WEIGHT = 64.0;
+
+	/// Minimal sum of weights accepted without rebuild.
+	static constexpr double MIN_TOTAL_WEIGHT = 1e-64;
+
+	/// Number of elements.
+	size_t size;
+
+	/// Number of leaves of the tree (power of two).
+	size_t leaves;
+
+	/// Temperature.
+	double tau;
+
+	/// Value subtracted from all values before exponentiation.
+	float shift;
+
+	/// Values of elements.
+	std::vector<float> values;
+
+	/// The sum-tree - node k has children 2k and 2k+1, the leaves start at index leaves (index 0 is unused).
+	std::vector<double> tree;
+};
+
+} /* namespace types */
+} /* namespace mic */
+
+#endif /* SRC_TYPES_SOFTMAXSAMPLER_HPP_ */
@@ -27,12 +27,16 @@
 #include <types/Position2D.hpp>
 #include <types/MatrixTypes.hpp>
 
+#include <deque>
+
 
 namespace mic {
 namespace types {
 
 /*!
- * \brief Structure storing a spatial experience - a triplet of position in time t, executed action and position in time t+1.
+ * \brief Structure storing a spatial experience - a triplet of position in time t, executed action and position in time t+n.
+ * In the case of multi-step (n-step) experiences the structure additionally stores the discounted sum of rewards collected in steps t..t+n-1
+ * and the discount factor that should be applied to the value of the state t+n (equal to zero if the chain ended in a terminal state).
  * \author tkornuta
  */
 struct SpatialExperience {
@@ -42,19 +46,29 @@ struct SpatialExperience {
 	/// Action at time t.
 	mic::types::NESWAction a_t;
 
-	/// State at time t+1 (t prim).
+	/// State at time t+1 (t prim) - or t+n in the case of multi-step experiences.
 	mic::types::Position2D s_t_prim;
 
+	/// Discounted sum of rewards collected between t and s_t_prim.
+	float reward;
+
+	/// Discount factor applied to the value of s_t_prim (gamma^n, zero if the chain has ended in a terminal state).
+	float discount;
+
 	/*!
 	 * Default constructor.
 	 * @param s_t_ State at time t.
 	 * @param a_t_ Action at time t.
 	 * @param s_t_prim_ State at time t+1 (t prim).
+	 * @param reward_ Reward received for the transition (default: 0).
+	 * @param discount_ Discount factor of the value of the state t+1 (default: 0).
 	 */
-	SpatialExperience(mic::types::Position2D s_t_, mic::types::NESWAction a_t_, mic::types::Position2D s_t_prim_) {
+	SpatialExperience(mic::types::Position2D s_t_, mic::types::NESWAction a_t_, mic::types::Position2D s_t_prim_, float reward_ = 0.0f, float discount_ = 0.0f) {
 		s_t = s_t_;
 		a_t = a_t_;
 		s_t_prim = s_t_prim_;
+		reward = reward_;
+		discount = discount_;
 	}
 
 };
@@ -92,7 +106,8 @@ public:
 	 * @param number_of_experiences_ The size of the experience table.
 	 * @param batch_size_ The batch size.
 	 */
-	SpatialExperienceMemory(size_t number_of_experiences_, size_t batch_size_) : Batch(batch_size_), number_of_experiences(number_of_experiences_) {
+	SpatialExperienceMemory(size_t number_of_experiences_, size_t batch_size_) : Batch(batch_size_), number_of_experiences(number_of_experiences_),
+		multistep_horizon(1), multistep_discount(1.0f) {
 
 	}
 
@@ -128,10 +143,97 @@ public:
 		sample_indices.push_back(sample_indices.size());
 	}
 
+	/*!
+	 * Sets the parameters of multi-step (n-step) returns.
+	 * @param horizon_ Number of steps (n) after which the experience is bootstrapped (1 means classic one-step experiences).
+	 * @param discount_ Discount factor (gamma) used for accumulation of the rewards.
+	 */
+	void setMultiStepParameters(size_t horizon_, float discount_) {
+		// Flush the experiences collected with the previous settings.
+		flushPendingTransitions();
+		multistep_horizon = (horizon_ > 0) ? horizon_ : 1;
+		multistep_discount = discount_;
+	}
+
+	/*!
+	 * Adds a single transition (t -> t+1) to the memory.
+	 * The transition updates the rewards of all pending (not completed yet) multi-step experiences.
+	 * An experience is moved to the memory when it covers the whole horizon or when the chain has ended.
+	 * @param input_ Experience (s_t, a_t, s_t+1).
+	 * @param target_ Sample target.
+	 * @param reward_ Reward received for the transition.
+	 * @param terminal_ Flag indicating that the state t+1 is terminal - all chains end here.
+	 * @param blocked_ Flag indicating that the move was not possible - only the chain starting with this transition ends here
+	 * (it is stored without bootstrapping), while the older chains continue.
+	 */
+	void addTransition(std::shared_ptr<mic::types::SpatialExperience> input_, std::shared_ptr<mic::types::MatrixXf> target_, float reward_, bool terminal_, bool blocked_ = false) {
+		// Update all pending chains: accumulate the discounted reward and move their last state.
+		for (size_t i=0; i<pending_data.size(); i++) {
+			std::shared_ptr<mic::types::SpatialExperience> exp = pending_data[i];
+			exp->reward += exp->discount * reward_;
+			exp->discount *= multistep_discount;
+			exp->s_t_prim = input_->s_t_prim;
+			pending_lengths[i]++;
+		}//: for
+
+		input_->reward = reward_;
+		if (blocked_) {
+			// The chain starting with this transition is complete.
+			input_->discount = 0.0f;
+			add(input_, target_);
+		} else {
+			// Start a new chain.
+			input_->discount = multistep_discount;
+			pending_data.push_back(input_);
+			pending_labels.push_back(target_);
+			pending_lengths.push_back(1);
+		}//: else
+
+		if (terminal_) {
+			// Do not bootstrap from the terminal state - finish all chains.
+			for (size_t i=0; i<pending_data.size(); i++)
+				pending_data[i]->discount = 0.0f;
+			flushPendingTransitions();
+		} else if ((!pending_data.empty()) && (pending_lengths.front() >= multistep_horizon)) {
+			// The oldest chain covers the whole horizon.
+			add(pending_data.front(), pending_labels.front());
+			pending_data.pop_front();
+			pending_labels.pop_front();
+			pending_lengths.pop_front();
+		}//: else
+	}
+
+	/*!
+	 * Moves all pending (i.e. shorter than horizon) experiences to the memory - should be called at the end of an episode.
+	 */
+	void flushPendingTransitions() {
+		while (!pending_data.empty()) {
+			add(pending_data.front(), pending_labels.front());
+			pending_data.pop_front();
+			pending_labels.pop_front();
+			pending_lengths.pop_front();
+		}//: while
+	}
+
 protected:
 
 	/// Size of the experience table (maximum number of stored experiences).
 	size_t number_of_experiences;
+
+	/// Multi-step horizon (n).
+	size_t multistep_horizon;
+
+	/// Discount factor used for accumulation of multi-step rewards.
+	float multistep_discount;
+
+	/// Experiences that do not cover the whole horizon yet.
+	std::deque<std::shared_ptr<mic::types::SpatialExperience> > pending_data;
+
+	/// Targets associated with pending experiences.
+	std::deque<std::shared_ptr<mic::types::MatrixXf> > pending_labels;
+
+	/// Numbers of transitions covered by the pending experiences.
+	std::deque<size_t> pending_lengths;
 };
 
 
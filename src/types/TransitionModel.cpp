@@ -0,0 +1,124 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file TransitionModel.cpp
+ * \brief Contains definition of the transition model of the gridworld.
+ * \author tkornut
+ * \date Oct 18, 2026
+ */
+
+#include <types/TransitionModel.hpp>
+
+#include <algorithm>
+
+namespace mic {
+namespace types {
+
+TransitionModel::TransitionModel() : width(0), height(0), number_of_states(0) {
+	offsets.push_back(0);
+}
+
+
+void TransitionModel::addTransition(uint32_t next_state_, float probability_, float reward_) {
+	next_states.push_back(next_state_);
+	probabilities.push_back(probability_);
+	rewards.push_back(reward_);
+}
+
+
+void TransitionModel::build(mic::environments::Gridworld & env_, float step_reward_, float move_noise_) {
+	width = env_.getEnvironmentWidth();
+	height = env_.getEnvironmentHeight();
+	number_of_states = width * height;
+
+	state_flags.assign(number_of_states, 0);
+	state_rewards.assign(number_of_states, 0.0f);
+	action_masks.assign(number_of_states, 0);
+	offsets.clear();
+	offsets.reserve(number_of_states * 4 + 1);
+	next_states.clear();
+	probabilities.clear();
+	rewards.clear();
+
+	// Fill the state properties.
+	for (size_t y=0; y<height; y++){
+		for (size_t x=0; x<width; x++) {
+			size_t s = stateIndex(x, y);
+			mic::types::Position2D pos(x,y);
+			if (env_.isStateAllowed(pos))
+				state_flags[s] |= StateAllowed;
+			if (env_.isStateTerminal(pos))
+				state_flags[s] |= StateTerminal;
+			state_rewards[s] = env_.getStateReward(pos);
+			for (size_t a=0; a<4; a++) {
+				if (env_.isActionAllowed(x, y, a))
+					action_masks[s] |= (1 << a);
+			}//: for
+		}//: for x
+	}//: for y
+
+	// Perpendicular actions - NESW order.
+	const size_t slips[4][2] = { {1, 3}, {0, 2}, {1, 3}, {0, 2} };
+
+	// Fill the transitions - only for allowed, non-terminal states.
+	for (size_t s=0; s<number_of_states; s++) {
+		long x = s % width;
+		long y = s / width;
+		for (size_t a=0; a<4; a++) {
+			offsets.push_back(next_states.size());
+			if ((!isStateAllowed(s)) || isStateTerminal(s) || (!isActionAllowed(s, a)))
+				continue;
+
+			// Intended move.
+			mic::types::Position2D next = mic::types::Position2D(x,y) + mic::types::NESWAction(a);
+			addTransition(stateIndex(next.x, next.y), 1 - move_noise_, step_reward_);
+
+			// Slips.
+			if (move_noise_ <= 0)
+				continue;
+			for (size_t slip : slips[a]) {
+				if (!isActionAllowed(s, slip))
+					continue;
+				mic::types::Position2D slip_pos = mic::types::Position2D(x,y) + mic::types::NESWAction(slip);
+				addTransition(stateIndex(slip_pos.x, slip_pos.y), move_noise_/2, step_reward_);
+			}//: for
+		}//: for a
+	}//: for s
+	offsets.push_back(next_states.size());
+
+	// Collect the unique predecessors of states.
+	std::vector<std::pair<uint32_t, uint32_t> > edges;
+	edges.reserve(next_states.size());
+	for (size_t s=0; s<number_of_states; s++)
+		for (uint32_t t=offsets[s * 4]; t<offsets[s * 4 + 4]; t++)
+			edges.push_back(std::make_pair(next_states[t], (uint32_t)s));
+	std::sort(edges.begin(), edges.end());
+	edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+	predecessor_offsets.assign(number_of_states + 1, 0);
+	predecessors.resize(edges.size());
+	for (size_t i=0; i<edges.size(); i++) {
+		predecessor_offsets[edges[i].first + 1]++;
+		predecessors[i] = edges[i].second;
+	}//: for
+	for (size_t s=0; s<number_of_states; s++)
+		predecessor_offsets[s + 1] += predecessor_offsets[s];
+
+	LOG(LINFO) << "Built the transition model with " << number_of_states << " states and " << next_states.size() << " transitions";
+}
+
+} /* namespace types */
+} /* namespace mic */
@@ -0,0 +1,170 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file TransitionModel.hpp
+ * \brief Contains declaration of the transition model of the gridworld, used by tabular solvers.
+ * \author tkornut
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_TYPES_TRANSITIONMODEL_HPP_
+#define SRC_TYPES_TRANSITIONMODEL_HPP_
+
+#include <vector>
+#include <cstdint>
+
+#include <types/Gridworld.hpp>
+
+namespace mic {
+namespace types {
+
+/*!
+ * \brief Transition model of the gridworld, precomputed once and stored in a CSR-like form.
+ * For every allowed (state, action) pair it stores the list of transitions (next state, probability, reward).
+ * The first transition of the list is always the intended move, the following ones are the "slips" to the perpendicular
+ * directions (caused by the move noise). Probabilities of slips into forbidden states (walls, outside of the grid) are dropped,
+ * so the solvers normalize the probabilities over the transitions they actually take into account.
+ * Additionally the model stores the predecessors of every state (used e.g. by prioritized sweeping).
+ * States are indexed in row-major order (y * width + x), actions according to NESW.
+ * \author tkornuta
+ */
+class TransitionModel {
+public:
+	/*!
+	 * Constructor. Creates an empty model.
+	 */
+	TransitionModel();
+
+	/*!
+	 * Builds the model on the basis of the current state of the gridworld.
+	 * @param env_ Gridworld.
+	 * @param step_reward_ Reward received by performing each step.
+	 * @param move_noise_ Move noise, determining how often action results in unintended (perpendicular) direction.
+	 */
+	void build(mic::environments::Gridworld & env_, float step_reward_, float move_noise_);
+
+	/// Returns the number of states.
+	inline size_t getNumberOfStates() { return number_of_states; }
+
+	/// Returns the width of the gridworld the model was built for.
+	inline size_t getWidth() { return width; }
+
+	/// Returns the height of the gridworld the model was built for.
+	inline size_t getHeight() { return height; }
+
+	/*!
+	 * Returns the index of the state.
+	 * @param x_ X coordinate.
+	 * @param y_ Y coordinate.
+	 * @return Index of the state.
+	 */
+	inline size_t stateIndex(size_t x_, size_t y_) { return y_ * width + x_; }
+
+	/// Returns true if the state is allowed (i.e. there is no wall).
+	inline bool isStateAllowed(size_t state_) { return state_flags[state_] & StateAllowed; }
+
+	/// Returns true if the state is terminal (goal or pit).
+	inline bool isStateTerminal(size_t state_) { return state_flags[state_] & StateTerminal; }
+
+	/// Returns the reward associated with the state.
+	inline float getStateReward(size_t state_) { return state_rewards[state_]; }
+
+	/// Returns the mask of actions allowed in the given state (bit a set if action a is allowed).
+	inline uint8_t getActionMask(size_t state_) { return action_masks[state_]; }
+
+	/// Returns true if the action performed in the given state is allowed.
+	inline bool isActionAllowed(size_t state_, size_t action_) { return (action_masks[state_] >> action_) & 1; }
+
+	/// Returns the index of the first transition of the (state, action) pair.
+	inline uint32_t transitionsBegin(size_t state_, size_t action_) { return offsets[state_ * 4 + action_]; }
+
+	/// Returns the index following the last transition of the (state, action) pair.
+	inline uint32_t transitionsEnd(size_t state_, size_t action_) { return offsets[state_ * 4 + action_ + 1]; }
+
+	/// Returns the array of next states (of all transitions).
+	inline const uint32_t* getNextStates() { return next_states.data(); }
+
+	/// Returns the array of probabilities (of all transitions).
+	inline const float* getProbabilities() { return probabilities.data(); }
+
+	/// Returns the array of rewards (of all transitions).
+	inline const float* getRewards() { return rewards.data(); }
+
+	/// Returns the index of the first predecessor of the state.
+	inline uint32_t predecessorsBegin(size_t state_) { return predecessor_offsets[state_]; }
+
+	/// Returns the index following the last predecessor of the state.
+	inline uint32_t predecessorsEnd(size_t state_) { return predecessor_offsets[state_ + 1]; }
+
+	/// Returns the array of predecessors (states from which the given state can be reached in a single transition).
+	inline const uint32_t* getPredecessors() { return predecessors.data(); }
+
+private:
+	/// Flags describing the state.
+	enum StateFlags : uint8_t {
+		StateAllowed = 1 << 0, ///< State is allowed
+		StateTerminal = 1 << 1 ///< State is terminal
+	};
+
+	/*!
+	 * Adds a transition to the list of the current (state, action) pair.
+	 * @param next_state_ Index of the next state.
+	 * @param probability_ Probability of the transition.
+	 * @param reward_ Reward received for the transition.
+	 */
+	void addTransition(uint32_t next_state_, float probability_, float reward_);
+
+	/// Width of the gridworld.
+	size_t width;
+
+	/// Height of the gridworld.
+	size_t height;
+
+	/// Number of states (width * height).
+	size_t number_of_states;
+
+	/// Flags of states.
+	std::vector<uint8_t> state_flags;
+
+	/// Rewards associated with states.
+	std::vector<float> state_rewards;
+
+	/// Masks of allowed actions (bit a set if action a is allowed).
+	std::vector<uint8_t> action_masks;
+
+	/// Offsets of transition lists of (state, action) pairs - of size number_of_states * 4 + 1.
+	std::vector<uint32_t> offsets;
+
+	/// Next states of all transitions.
+	std::vector<uint32_t> next_states;
+
+	/// Probabilities of all transitions.
+	std::vector<float> probabilities;
+
+	/// Rewards of all transitions.
+	std::vector<float> rewards;
+
+	/// Offsets of predecessor lists of states - of size number_of_states + 1.
+	std::vector<uint32_t> predecessor_offsets;
+
+	/// Predecessors of all states (unique).
+	std::vector<uint32_t> predecessors;
+};
+
+} /* namespace types */
+} /* namespace mic */
+
+#endif /* SRC_TYPES_TRANSITIONMODEL_HPP_ */
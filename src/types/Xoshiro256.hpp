@@ -0,0 +1,127 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file Xoshiro256.hpp
+ * \brief Contains declaration (and definition) of a small, fast and seedable pseudo-random generator.
+ * \author tkornut
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_TYPES_XOSHIRO256_HPP_
+#define SRC_TYPES_XOSHIRO256_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+
+namespace mic {
+namespace types {
+
+/*!
+ * \brief The xoshiro256** pseudo-random generator (Blackman, Vigna).
+ * Its state is only 32 bytes, so it is cheap to construct, copy and seed, unlike std::mt19937_64 seeded from std::random_device.
+ * Satisfies the requirements of UniformRandomBitGenerator, hence it can be used with the standard distributions.
+ * Independent streams (e.g. for parallel workers) are obtained by jumping ahead by 2^128 steps.
+ * \author tkornuta
+ */
+class Xoshiro256 {
+public:
+	/// Type of the generated numbers.
+	typedef uint64_t result_type;
+
+	/*!
+	 * Constructor.
+	 * @param seed_ Seed of the generator.
+	 * @param stream_ Index of the stream (number of jumps performed after seeding).
+	 */
+	Xoshiro256(uint64_t seed_ = 0, size_t stream_ = 0) {
+		seed(seed_, stream_);
+	}
+
+	/*!
+	 * Seeds the generator - the state is filled with the consecutive outputs of splitmix64.
+	 * @param seed_ Seed of the generator.
+	 * @param stream_ Index of the stream (number of jumps performed after seeding).
+	 */
+	void seed(uint64_t seed_, size_t stream_ = 0) {
+		for (size_t i=0; i<4; i++) {
+			seed_ += 0x9e3779b97f4a7c15ULL;
+			uint64_t z = seed_;
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+			s[i] = z ^ (z >> 31);
+		}//: for
+		for (size_t i=0; i<stream_; i++)
+			jump();
+	}
+
+	/*!
+	 * Returns the next random number.
+	 */
+	result_type operator()() {
+		const uint64_t result = rotl(s[1] * 5, 7) * 9;
+		const uint64_t t = s[1] << 17;
+
+		s[2] ^= s[0];
+		s[3] ^= s[1];
+		s[1] ^= s[2];
+		s[0] ^= s[3];
+		s[2] ^= t;
+		s[3] = rotl(s[3], 45);
+
+		return result;
+	}
+
+	/*!
+	 * Advances the generator by 2^128 steps - the sequences of consecutive jumps do not overlap.
+	 */
+	void jump() {
+		static const uint64_t JUMP[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+
+		uint64_t t[4] = { 0, 0, 0, 0 };
+		for (size_t i=0; i<4; i++) {
+			for (size_t b=0; b<64; b++) {
+				if (JUMP[i] & (1ULL << b))
+					for (size_t j=0; j<4; j++)
+						t[j] ^= s[j];
+				(*this)();
+			}//: for b
+		}//: for i
+
+		for (size_t j=0; j<4; j++)
+			s[j] = t[j];
+	}
+
+	/// Returns the minimal generated value.
+	static constexpr result_type min() { return std::numeric_limits<result_type>::min(); }
+
+	/// Returns the maximal generated value.
+	static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+private:
+	/// Rotates the bits to the left.
+	static inline uint64_t rotl(const uint64_t x_, int k_) {
+		return (x_ << k_) | (x_ >> (64 - k_));
+	}
+
+	/// State of the generator.
+	uint64_t s[4];
+};
+
+} /* namespace types */
+} /* namespace mic */
+
+#endif /* SRC_TYPES_XOSHIRO256_HPP_ */